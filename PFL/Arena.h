@@ -0,0 +1,342 @@
+#pragma once
+
+/*
+    ###################################################################################
+    Arena.h
+    Linear (bump-pointer) arena allocator with marker/rewind, and a double-buffered per-frame variant.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 201703L
+#include <memory_resource>
+#endif
+
+namespace pfl
+{
+    /**
+    * Linear (bump-pointer) allocator over a fixed-capacity memory block.
+    * Allocation is a pointer increment, and memory is freed only in bulk by rewind() or reset().
+    * Meant for transient data whose lifetime ends at a known point, e.g. at the end of a frame.
+    *
+    * In debug builds (NDEBUG not defined), newly allocated memory is filled with 0xCD and freed memory with 0xDD,
+    * so use of uninitialized or freed arena memory shows up quickly.
+    *
+    * Not thread-safe.
+    */
+    class LinearArena
+    {
+
+    public:
+
+        typedef size_t Marker;  /**< Position in the arena, see getMarker() and rewind(). */
+
+        /**
+        * @param capacity Size of the memory block in bytes, allocated once here.
+        *                 Must be positive.
+        *                 Exception is thrown for zero value.
+        */
+        LinearArena(const size_t& capacity) :
+            m_nCapacity(capacity)
+        {
+            if (!capacity)
+            {
+                throw std::runtime_error("Capacity must be positive!");
+            }
+
+            m_buffer.reset(new unsigned char[capacity]);
+            poison(0, m_nCapacity, FreedByte);
+        }
+
+        ~LinearArena() = default;
+
+        LinearArena(const LinearArena&) = delete;
+        LinearArena& operator=(const LinearArena&) = delete;
+        /**
+        * The moved-from arena is left empty with zero capacity: it can still be used, but every allocation from it fails.
+        */
+        LinearArena(LinearArena&& other) noexcept :
+            m_buffer(std::move(other.m_buffer)),
+            m_nCapacity(std::exchange(other.m_nCapacity, 0)),
+            m_nUsed(std::exchange(other.m_nUsed, 0)),
+            m_nPeak(std::exchange(other.m_nPeak, 0))
+        {
+        }
+
+        LinearArena& operator=(LinearArena&& other) noexcept
+        {
+            if (this != &other)
+            {
+                m_buffer = std::move(other.m_buffer);
+                m_nCapacity = std::exchange(other.m_nCapacity, 0);
+                m_nUsed = std::exchange(other.m_nUsed, 0);
+                m_nPeak = std::exchange(other.m_nPeak, 0);
+            }
+            return *this;
+        }
+
+        /**
+        * Allocates a memory block.
+        * Complexity: O(1) constant.
+        *
+        * @param nSize      Size of the block in bytes.
+        * @param nAlignment Alignment of the block, must be a power of 2.
+        *
+        * @return Pointer to the allocated block, or nullptr if there is not enough space left in the arena.
+        */
+        void* allocate(size_t nSize, size_t nAlignment = alignof(std::max_align_t))
+        {
+            assert(nAlignment && ((nAlignment & (nAlignment - 1)) == 0));
+
+            const uintptr_t nBase = reinterpret_cast<uintptr_t>(m_buffer.get());
+            const uintptr_t nAligned = (nBase + m_nUsed + (nAlignment - 1)) & ~static_cast<uintptr_t>(nAlignment - 1);
+            const size_t nBegin = static_cast<size_t>(nAligned - nBase);
+            if (!m_buffer || (nBegin > m_nCapacity) || (nSize > m_nCapacity - nBegin))
+            {
+                return nullptr;
+            }
+
+            m_nUsed = nBegin + nSize;
+            if (m_nUsed > m_nPeak)
+            {
+                m_nPeak = m_nUsed;
+            }
+            poison(nBegin, nSize, AllocatedByte);
+            return m_buffer.get() + nBegin;
+        }
+
+        /**
+        * Allocates uninitialized storage for nCount objects of type T.
+        *
+        * @return Pointer to the first element, or nullptr if there is not enough space left in the arena.
+        */
+        template <typename T>
+        T* allocateArray(size_t nCount)
+        {
+            if (nCount > (static_cast<size_t>(-1) / sizeof(T)))
+            {
+                return nullptr;
+            }
+            return static_cast<T*>(allocate(sizeof(T) * nCount, alignof(T)));
+        }
+
+        /**
+        * Allocates and constructs an object of type T.
+        * Destructors are never invoked by the arena, so only trivially destructible types are allowed.
+        *
+        * @return Pointer to the new object, or nullptr if there is not enough space left in the arena.
+        */
+        template <typename T, typename... Args>
+        T* create(Args&&... args)
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "Arena never invokes destructors!");
+            void* const p = allocate(sizeof(T), alignof(T));
+            return p ? new (p) T(std::forward<Args>(args)...) : nullptr;
+        }
+
+        /**
+        * @return The current position in the arena, to be later given to rewind().
+        */
+        Marker getMarker() const
+        {
+            return m_nUsed;
+        }
+
+        /**
+        * Frees everything allocated after the given marker was taken.
+        * Complexity: O(1) constant (plus poisoning in debug builds).
+        *
+        * @param marker A marker returned by getMarker() since the last reset(), or an earlier rewind() to an older marker.
+        */
+        void rewind(Marker marker)
+        {
+            assert(marker <= m_nUsed);
+            poison(marker, m_nUsed - marker, FreedByte);
+            m_nUsed = marker;
+        }
+
+        /**
+        * Frees everything allocated from the arena.
+        * Complexity: O(1) constant (plus poisoning in debug builds).
+        */
+        void reset()
+        {
+            rewind(0);
+        }
+
+        /**
+        * @return Number of bytes currently used, including alignment padding.
+        */
+        size_t size() const
+        {
+            return m_nUsed;
+        }
+
+        /**
+        * @return Capacity of the arena in bytes.
+        */
+        size_t capacity() const
+        {
+            return m_nCapacity;
+        }
+
+        /**
+        * @return Highest number of bytes ever used at once. Useful for tuning the capacity.
+        */
+        size_t peak() const
+        {
+            return m_nPeak;
+        }
+
+    private:
+        static const unsigned char AllocatedByte = 0xCD;
+        static const unsigned char FreedByte = 0xDD;
+
+        std::unique_ptr<unsigned char[]> m_buffer;
+        size_t m_nCapacity = 0;
+        size_t m_nUsed = 0;       /**< Offset of the first free byte. */
+        size_t m_nPeak = 0;
+
+        void poison(size_t nOffset, size_t nSize, unsigned char value)
+        {
+#ifndef NDEBUG
+            if (m_buffer)
+            {
+                memset(m_buffer.get() + nOffset, value, nSize);
+            }
+#else
+            (void)nOffset;
+            (void)nSize;
+            (void)value;
+#endif
+        }
+
+    }; // class LinearArena
+
+    /**
+    * Double-buffered linear arena for per-frame temporaries.
+    * Allocations made during a frame stay valid during the next frame too, so data can be handed over from one frame to the next
+    * (e.g. from simulation to rendering) without copying. beginFrame() frees the allocations made 2 frames ago with a single reset.
+    *
+    * Not thread-safe.
+    */
+    class FrameArena
+    {
+
+    public:
+
+        /**
+        * @param capacity Capacity of each of the 2 underlying arenas in bytes.
+        *                 Must be positive.
+        *                 Exception is thrown for zero value.
+        */
+        FrameArena(const size_t& capacity) :
+            m_arenas{ { LinearArena(capacity), LinearArena(capacity) } }
+        {
+        }
+
+        ~FrameArena() = default;
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+        FrameArena(FrameArena&&) = default;
+        FrameArena& operator=(FrameArena&&) = default;
+
+        /**
+        * Switches to the other arena and resets it, i.e. frees the allocations made 2 frames ago.
+        * To be invoked once at the beginning of each frame.
+        */
+        void beginFrame()
+        {
+            m_iCurrent ^= 1u;
+            m_arenas[m_iCurrent].reset();
+        }
+
+        /**
+        * Allocates from the arena of the current frame. See LinearArena::allocate().
+        */
+        void* allocate(size_t nSize, size_t nAlignment = alignof(std::max_align_t))
+        {
+            return m_arenas[m_iCurrent].allocate(nSize, nAlignment);
+        }
+
+        /**
+        * @return The arena of the current frame.
+        */
+        LinearArena& current()
+        {
+            return m_arenas[m_iCurrent];
+        }
+
+        /**
+        * @return The arena of the previous frame. Its allocations are still valid but it shall not be allocated from.
+        */
+        const LinearArena& previous() const
+        {
+            return m_arenas[m_iCurrent ^ 1u];
+        }
+
+    private:
+        std::array<LinearArena, 2> m_arenas;
+        size_t m_iCurrent = 0;
+
+    }; // class FrameArena
+
+#if __cplusplus >= 201703L
+    /**
+    * Adapter for using a LinearArena as std::pmr::memory_resource, so standard containers (std::pmr::vector, std::pmr::string, ...)
+    * can allocate from the arena.
+    * Deallocation does nothing, memory is freed by rewinding or resetting the arena. Containers must not outlive that point.
+    * Throws std::bad_alloc if the arena is exhausted, as required by std::pmr::memory_resource.
+    */
+    class ArenaMemoryResource : public std::pmr::memory_resource
+    {
+
+    public:
+
+        explicit ArenaMemoryResource(LinearArena& arena) :
+            m_arena(arena)
+        {
+        }
+
+    protected:
+
+        void* do_allocate(size_t nBytes, size_t nAlignment) override
+        {
+            void* const p = m_arena.allocate(nBytes, nAlignment);
+            if (!p)
+            {
+                throw std::bad_alloc();
+            }
+            return p;
+        }
+
+        void do_deallocate(void*, size_t, size_t) override
+        {
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    private:
+        LinearArena& m_arena;
+
+    }; // class ArenaMemoryResource
+#endif
+
+} // namespace
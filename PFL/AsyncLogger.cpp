@@ -0,0 +1,445 @@
+/*
+    ###################################################################################
+    AsyncLogger.cpp
+    Asynchronous logger: producers write binary records into per-thread rings, a background thread formats and writes them.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include "AsyncLogger.h"
+
+#include <ctime>
+#include <stdexcept>
+
+
+namespace
+{
+    /** Ring capacity is rounded up to a power of 2, and to at least this. */
+    constexpr size_t nMinRingCapacity = 256;
+
+    /** Formatted text collected by the background thread is passed to the sink when reaching this size, or when all rings are drained. */
+    constexpr size_t nMaxBatchSize = 64 * 1024;
+
+    /** Source of unique logger ids, 0 is reserved for empty cache entries. */
+    std::atomic<uint64_t> nNextLoggerId(1);
+
+    const char* const aszLevelNames[] = { "DEBUG", "INFO ", "WARN ", "ERROR" };
+
+    size_t roundUpToPowerOf2(size_t nValue)
+    {
+        size_t nResult = nMinRingCapacity;
+        while (nResult < nValue)
+        {
+            nResult *= 2;
+        }
+        return nResult;
+    } // roundUpToPowerOf2()
+
+    template <typename T>
+    T readValue(const char*& pSrc)
+    {
+        T value;
+        std::memcpy(&value, pSrc, sizeof(value));
+        pSrc += sizeof(value);
+        return value;
+    } // readValue()
+
+    /**
+        Appends the text of the next argument of a record.
+    */
+    void appendArg(const char*& pSrc, std::string& sOut)
+    {
+        char szBuffer[64];
+        const pfl::detail::LogArgTag tag = static_cast<pfl::detail::LogArgTag>(*pSrc++);
+        switch (tag)
+        {
+        case pfl::detail::LogArgTag::Bool:
+            sOut += readValue<uint8_t>(pSrc) ? "true" : "false";
+            return;
+        case pfl::detail::LogArgTag::Char:
+            sOut += readValue<char>(pSrc);
+            return;
+        case pfl::detail::LogArgTag::Int:
+            snprintf(szBuffer, sizeof(szBuffer), "%lld", static_cast<long long>(readValue<int64_t>(pSrc)));
+            break;
+        case pfl::detail::LogArgTag::UInt:
+            snprintf(szBuffer, sizeof(szBuffer), "%llu", static_cast<unsigned long long>(readValue<uint64_t>(pSrc)));
+            break;
+        case pfl::detail::LogArgTag::Double:
+            snprintf(szBuffer, sizeof(szBuffer), "%g", readValue<double>(pSrc));
+            break;
+        case pfl::detail::LogArgTag::Pointer:
+            snprintf(szBuffer, sizeof(szBuffer), "%p", readValue<const void*>(pSrc));
+            break;
+        case pfl::detail::LogArgTag::String:
+        {
+            const uint32_t nLength = readValue<uint32_t>(pSrc);
+            sOut.append(pSrc, nLength);
+            pSrc += nLength;
+            return;
+        }
+        default:
+            return;
+        }
+        sOut += szBuffer;
+    } // appendArg()
+
+} // namespace
+
+
+thread_local pfl::AsyncLogger::LocalRingCacheEntry pfl::AsyncLogger::s_localRingCache[LocalRingCacheSize] = {};
+
+constexpr size_t pfl::AsyncLogger::LocalRingCacheSize;
+
+
+// ############################### PUBLIC ################################
+
+
+/**
+    Starts the background thread.
+
+    @param sink          Invoked on the background thread with batches of formatted lines.
+    @param nRingCapacity Size of the ring of each logging thread in bytes. Rounded up to power of 2, min 256.
+                         A single record can take at most half of it.
+    @param policy        What a logging call does when the ring of its thread is full.
+    @param pollInterval  Time the background thread sleeps when all rings are empty.
+                         Logging calls do not wake it up, so this is the latency of the output.
+*/
+pfl::AsyncLogger::AsyncLogger(Sink sink, size_t nRingCapacity, LogFullPolicy policy, std::chrono::milliseconds pollInterval) :
+    m_nId(nNextLoggerId.fetch_add(1, std::memory_order_relaxed)),
+    m_nRingCapacity(roundUpToPowerOf2(nRingCapacity)),
+    m_policy(policy),
+    m_pollInterval(pollInterval),
+    m_nMinLevel(static_cast<uint8_t>(LogLevel::Debug)),
+    m_nDropped(0)
+{
+    init(std::move(sink));
+} // AsyncLogger()
+
+
+/**
+    Same as the other constructor, with appending to the given file as sink. The file is flushed after each batch.
+    Exception is thrown if the file cannot be opened.
+*/
+pfl::AsyncLogger::AsyncLogger(const char* pszFilename, size_t nRingCapacity, LogFullPolicy policy, std::chrono::milliseconds pollInterval) :
+    m_nId(nNextLoggerId.fetch_add(1, std::memory_order_relaxed)),
+    m_nRingCapacity(roundUpToPowerOf2(nRingCapacity)),
+    m_policy(policy),
+    m_pollInterval(pollInterval),
+    m_nMinLevel(static_cast<uint8_t>(LogLevel::Debug)),
+    m_nDropped(0)
+{
+    m_pFile = fopen(pszFilename, "ab");
+    if (!m_pFile)
+    {
+        throw std::runtime_error(std::string("Failed to open log file: ") + pszFilename + "!");
+    }
+
+    FILE* const pFile = m_pFile;
+    init([pFile](const char* pData, size_t nSize) {
+        fwrite(pData, 1, nSize, pFile);
+        fflush(pFile);
+    });
+} // AsyncLogger()
+
+
+/**
+    Writes all records logged so far, then stops the background thread.
+    No logging call shall be running or made on other threads during and after destruction.
+*/
+pfl::AsyncLogger::~AsyncLogger()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStop = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+
+    if (m_pFile)
+    {
+        fclose(m_pFile);
+    }
+} // ~AsyncLogger()
+
+
+/**
+    Blocks until all records logged before this call by the calling thread, and by threads synchronized with it, are passed to the sink.
+    Useful before crashing on purpose, e.g. in an assert handler.
+*/
+void pfl::AsyncLogger::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const uint64_t nRequest = ++m_nFlushRequested;
+    m_cv.notify_one();
+    m_flushCv.wait(lock, [this, nRequest] { return m_nFlushDone >= nRequest; });
+} // flush()
+
+
+// ############################## PROTECTED ##############################
+
+
+// ############################### PRIVATE ###############################
+
+
+void pfl::AsyncLogger::init(Sink sink)
+{
+    m_sink = std::move(sink);
+    m_thread = std::thread(&AsyncLogger::run, this);
+} // init()
+
+
+/**
+    Finds or creates the ring of the calling thread, and puts it into the thread-local cache.
+*/
+pfl::AsyncLogger::Ring* pfl::AsyncLogger::localRingSlow()
+{
+    const std::thread::id threadId = std::this_thread::get_id();
+
+    Ring* pRing = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& pExisting : m_rings)
+        {
+            if (pExisting->threadId == threadId)
+            {
+                pRing = pExisting.get();
+                break;
+            }
+        }
+
+        if (!pRing)
+        {
+            std::unique_ptr<Ring> pNew(new Ring());
+            pNew->threadId = threadId;
+            pNew->nIndex = m_rings.size();
+            pNew->buffer.reset(new uint64_t[m_nRingCapacity / sizeof(uint64_t)]);
+            pNew->nWritePos.store(0, std::memory_order_relaxed);
+            pNew->nCachedReadPos = 0;
+            pNew->nReadPos.store(0, std::memory_order_relaxed);
+            pRing = pNew.get();
+            m_rings.push_back(std::move(pNew));
+        }
+    }
+
+    // replace the oldest entry
+    for (size_t i = LocalRingCacheSize - 1; i > 0; i--)
+    {
+        s_localRingCache[i] = s_localRingCache[i - 1];
+    }
+    s_localRingCache[0].nLoggerId = m_nId;
+    s_localRingCache[0].pRing = pRing;
+    return pRing;
+} // localRingSlow()
+
+
+/**
+    Reserves contiguous space for a record in the ring of the calling thread, waiting or dropping if it is full, as per the policy.
+    If the space left before the end of the ring is not enough, it is skipped by a padding record.
+
+    @param nSize   Unaligned size of the record.
+    @param pRing   Set to the ring of the calling thread.
+    @param nEndPos Set to the write position to be published when the record is written.
+
+    @return Start of the reserved space, or null if the record is dropped.
+*/
+char* pfl::AsyncLogger::beginRecord(size_t nSize, Ring*& pRing, uint64_t& nEndPos)
+{
+    pRing = localRing();
+
+    const size_t nRecordSize = alignRecordSize(nSize);
+    if (nRecordSize > m_nRingCapacity / 2)
+    {
+        // could never fit together with a padding record
+        m_nDropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    const uint64_t nWritePos = pRing->nWritePos.load(std::memory_order_relaxed);
+    const size_t nOffset = static_cast<size_t>(nWritePos & (m_nRingCapacity - 1));
+    const size_t nToEnd = m_nRingCapacity - nOffset;
+    const size_t nPadding = (nRecordSize > nToEnd) ? nToEnd : 0;
+    const uint64_t nNeeded = nPadding + nRecordSize;
+
+    if (nWritePos + nNeeded - pRing->nCachedReadPos > m_nRingCapacity)
+    {
+        pRing->nCachedReadPos = pRing->nReadPos.load(std::memory_order_acquire);
+        while (nWritePos + nNeeded - pRing->nCachedReadPos > m_nRingCapacity)
+        {
+            if (m_policy == LogFullPolicy::Drop)
+            {
+                m_nDropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            m_cv.notify_one();
+            std::this_thread::yield();
+            pRing->nCachedReadPos = pRing->nReadPos.load(std::memory_order_acquire);
+        }
+    }
+
+    char* const pBuffer = reinterpret_cast<char*>(pRing->buffer.get());
+    if (nPadding >= sizeof(RecordHeader))
+    {
+        // less space than a header is skipped implicitly
+        RecordHeader padding = {};
+        padding.nSize = static_cast<uint32_t>(nPadding);
+        std::memcpy(pBuffer + nOffset, &padding, sizeof(padding));
+    }
+
+    nEndPos = nWritePos + nNeeded;
+    return pBuffer + static_cast<size_t>((nWritePos + nPadding) & (m_nRingCapacity - 1));
+} // beginRecord()
+
+
+/**
+    Background thread: drains all rings periodically, or when flush or stop is requested.
+*/
+void pfl::AsyncLogger::run()
+{
+    std::string sBatch;
+    std::vector<Ring*> rings;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        const bool bStop = m_bStop;
+        const uint64_t nFlushRequested = m_nFlushRequested;
+        rings.clear();
+        for (const auto& pRing : m_rings)
+        {
+            rings.push_back(pRing.get());
+        }
+        lock.unlock();
+
+        for (Ring* const pRing : rings)
+        {
+            drainRing(*pRing, sBatch);
+        }
+        if (!sBatch.empty())
+        {
+            m_sink(sBatch.data(), sBatch.size());
+            sBatch.clear();
+        }
+
+        lock.lock();
+        if (m_nFlushDone != nFlushRequested)
+        {
+            m_nFlushDone = nFlushRequested;
+            m_flushCv.notify_all();
+        }
+        if (bStop)
+        {
+            return;
+        }
+        if (!m_bStop && (m_nFlushRequested == nFlushRequested))
+        {
+            m_cv.wait_for(lock, m_pollInterval);
+        }
+    }
+} // run()
+
+
+/**
+    Formats all records currently in the given ring, passing the text to the sink whenever the batch grows big.
+*/
+void pfl::AsyncLogger::drainRing(Ring& ring, std::string& sBatch)
+{
+    const char* const pBuffer = reinterpret_cast<const char*>(ring.buffer.get());
+    uint64_t nReadPos = ring.nReadPos.load(std::memory_order_relaxed);
+    const uint64_t nWritePos = ring.nWritePos.load(std::memory_order_acquire);
+
+    while (nReadPos < nWritePos)
+    {
+        const size_t nOffset = static_cast<size_t>(nReadPos & (m_nRingCapacity - 1));
+        const size_t nToEnd = m_nRingCapacity - nOffset;
+        if (nToEnd < sizeof(RecordHeader))
+        {
+            nReadPos += nToEnd;
+            continue;
+        }
+
+        RecordHeader header;
+        std::memcpy(&header, pBuffer + nOffset, sizeof(header));
+        if (header.pszFormat)
+        {
+            formatRecord(ring, pBuffer + nOffset, sBatch);
+        }
+        nReadPos += header.nSize;
+
+        // free the space as soon as possible for a blocked producer
+        ring.nReadPos.store(nReadPos, std::memory_order_release);
+
+        if (sBatch.size() >= nMaxBatchSize)
+        {
+            m_sink(sBatch.data(), sBatch.size());
+            sBatch.clear();
+        }
+    }
+} // drainRing()
+
+
+/**
+    Appends the given record as a line: local date and time with microseconds, level, thread ring index and the message.
+*/
+void pfl::AsyncLogger::formatRecord(const Ring& ring, const char* pRecord, std::string& sBatch)
+{
+    RecordHeader header;
+    std::memcpy(&header, pRecord, sizeof(header));
+    const char* pArgs = pRecord + sizeof(header);
+
+    // converting to local time is slow, so it is done only once per second
+    const int64_t nSecond = (header.nTimestampUs >= 0) ? (header.nTimestampUs / 1000000) : ((header.nTimestampUs - 999999) / 1000000);
+    if (nSecond != m_nLastFormattedSecond)
+    {
+        m_nLastFormattedSecond = nSecond;
+        const std::time_t time = static_cast<std::time_t>(nSecond);
+        std::tm tm = {};
+#ifdef _WIN32
+        localtime_s(&tm, &time);
+#else
+        localtime_r(&time, &tm);
+#endif
+        strftime(m_szLastFormattedSecond, sizeof(m_szLastFormattedSecond), "%Y-%m-%d %H:%M:%S", &tm);
+    }
+
+    char szPrefix[96];
+    snprintf(
+        szPrefix,
+        sizeof(szPrefix),
+        "%s.%06d %s [T%u] ",
+        m_szLastFormattedSecond,
+        static_cast<int>(header.nTimestampUs - nSecond * 1000000),
+        aszLevelNames[header.nLevel & 3],
+        static_cast<unsigned int>(ring.nIndex));
+    sBatch += szPrefix;
+
+    unsigned int nArgsLeft = header.nArgs;
+    for (const char* p = header.pszFormat; *p; p++)
+    {
+        if ((p[0] == '{') && (p[1] == '}'))
+        {
+            if (nArgsLeft > 0)
+            {
+                appendArg(pArgs, sBatch);
+                nArgsLeft--;
+            }
+            else
+            {
+                sBatch += "{}";
+            }
+            p++;
+        }
+        else if (((p[0] == '{') && (p[1] == '{')) || ((p[0] == '}') && (p[1] == '}')))
+        {
+            sBatch += p[0];
+            p++;
+        }
+        else
+        {
+            sBatch += *p;
+        }
+    }
+    sBatch += '\n';
+} // formatRecord()
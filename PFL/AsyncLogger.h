@@ -0,0 +1,386 @@
+#pragma once
+
+/*
+    ###################################################################################
+    AsyncLogger.h
+    Asynchronous logger: producers write binary records into per-thread rings, a background thread formats and writes them.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace pfl
+{
+    enum class LogLevel : uint8_t
+    {
+        Debug,
+        Info,
+        Warning,
+        Error
+    };
+
+    /**
+    * What a producer does when its ring is full.
+    */
+    enum class LogFullPolicy
+    {
+        Drop,   /**< The record is dropped and counted, the producer never waits. */
+        Block   /**< The producer waits until the background thread makes space. */
+    };
+
+    namespace detail
+    {
+        enum class LogArgTag : uint8_t
+        {
+            Bool,
+            Char,
+            Int,
+            UInt,
+            Double,
+            String,
+            Pointer
+        };
+
+        /**
+        * Binary encoding of a log argument: a tag byte followed by the raw value.
+        * Strings are copied (length and bytes), since they might not outlive the record.
+        * Not specialized for unsupported types, so logging them fails to compile.
+        */
+        template <typename T, typename Enable = void>
+        struct LogArg;
+
+        template <typename T>
+        void writeLogArgValue(char*& pDst, LogArgTag tag, const T& value)
+        {
+            *pDst++ = static_cast<char>(tag);
+            std::memcpy(pDst, &value, sizeof(value));
+            pDst += sizeof(value);
+        }
+
+        template <>
+        struct LogArg<bool>
+        {
+            static size_t size(bool) { return 2; }
+            static void write(char*& pDst, bool bValue) { writeLogArgValue(pDst, LogArgTag::Bool, static_cast<uint8_t>(bValue)); }
+        };
+
+        template <>
+        struct LogArg<char>
+        {
+            static size_t size(char) { return 2; }
+            static void write(char*& pDst, char c) { writeLogArgValue(pDst, LogArgTag::Char, c); }
+        };
+
+        template <typename T>
+        struct LogArg<T, typename std::enable_if<(std::is_integral<T>::value && std::is_signed<T>::value && !std::is_same<T, char>::value) || std::is_enum<T>::value>::type>
+        {
+            static size_t size(T) { return 1 + sizeof(int64_t); }
+            static void write(char*& pDst, T value) { writeLogArgValue(pDst, LogArgTag::Int, static_cast<int64_t>(value)); }
+        };
+
+        template <typename T>
+        struct LogArg<T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value>::type>
+        {
+            static size_t size(T) { return 1 + sizeof(uint64_t); }
+            static void write(char*& pDst, T value) { writeLogArgValue(pDst, LogArgTag::UInt, static_cast<uint64_t>(value)); }
+        };
+
+        template <typename T>
+        struct LogArg<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+        {
+            static size_t size(T) { return 1 + sizeof(double); }
+            static void write(char*& pDst, T value) { writeLogArgValue(pDst, LogArgTag::Double, static_cast<double>(value)); }
+        };
+
+        template <typename T>
+        struct LogArg<T*>
+        {
+            static size_t size(const T*) { return 1 + sizeof(const void*); }
+            static void write(char*& pDst, const T* p) { writeLogArgValue(pDst, LogArgTag::Pointer, static_cast<const void*>(p)); }
+        };
+
+        inline void writeLogArgString(char*& pDst, const char* pData, uint32_t nLength)
+        {
+            writeLogArgValue(pDst, LogArgTag::String, nLength);
+            std::memcpy(pDst, pData, nLength);
+            pDst += nLength;
+        }
+
+        template <>
+        struct LogArg<const char*>
+        {
+            static size_t size(const char* psz) { return 1 + sizeof(uint32_t) + (psz ? std::strlen(psz) : 0); }
+            static void write(char*& pDst, const char* psz) { writeLogArgString(pDst, psz ? psz : "", psz ? static_cast<uint32_t>(std::strlen(psz)) : 0); }
+        };
+
+        template <>
+        struct LogArg<char*> : public LogArg<const char*>
+        {
+        };
+
+        template <>
+        struct LogArg<std::string>
+        {
+            static size_t size(const std::string& str) { return 1 + sizeof(uint32_t) + str.size(); }
+            static void write(char*& pDst, const std::string& str) { writeLogArgString(pDst, str.data(), static_cast<uint32_t>(str.size())); }
+        };
+
+        inline size_t sumLogArgSizes()
+        {
+            return 0;
+        }
+
+        template <typename T, typename... Args>
+        size_t sumLogArgSizes(const T& arg, const Args&... args)
+        {
+            return LogArg<typename std::decay<T>::type>::size(arg) + sumLogArgSizes(args...);
+        }
+
+        inline void writeLogArgs(char*&)
+        {
+        }
+
+        template <typename T, typename... Args>
+        void writeLogArgs(char*& pDst, const T& arg, const Args&... args)
+        {
+            LogArg<typename std::decay<T>::type>::write(pDst, arg);
+            writeLogArgs(pDst, args...);
+        }
+    } // namespace detail
+
+    /**
+    * Asynchronous logger.
+    *
+    * A logging call does not format anything: it writes a compact binary record into the ring of the calling thread, holding the
+    * format string pointer, a timestamp and the raw argument values. A background thread drains the rings periodically, formats
+    * the records and passes them to the sink in batches. So logging costs a clock read and a few memcpy, no locking, no allocation
+    * and no I/O.
+    *
+    * The format string must outlive the logger, e.g. a string literal, since only its pointer is stored. Arguments are substituted
+    * for "{}" placeholders in order, "{{" and "}}" give literal braces. Supported argument types: bool, char, integers, enums,
+    * floating point, pointers, C strings and std::string (strings are copied into the record).
+    *
+    * Each thread gets its own single-producer single-consumer ring, modeled on FixFIFO but with variable-size records. Records of
+    * different threads are written in the order they are collected, which is only roughly chronological; each line has its timestamp.
+    * Rings are never freed before the logger, a ring is reused by a later thread getting the same thread id.
+    */
+    class AsyncLogger
+    {
+
+    public:
+
+        typedef std::function<void(const char* pData, size_t nSize)> Sink;
+
+        AsyncLogger(
+            Sink sink,
+            size_t nRingCapacity = 64 * 1024,
+            LogFullPolicy policy = LogFullPolicy::Drop,
+            std::chrono::milliseconds pollInterval = std::chrono::milliseconds(2));
+        AsyncLogger(
+            const char* pszFilename,
+            size_t nRingCapacity = 64 * 1024,
+            LogFullPolicy policy = LogFullPolicy::Drop,
+            std::chrono::milliseconds pollInterval = std::chrono::milliseconds(2));
+        ~AsyncLogger();
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+        AsyncLogger(AsyncLogger&&) = delete;
+        AsyncLogger& operator=(AsyncLogger&&) = delete;
+
+        /**
+        * Logs a record. Thread-safe, lock-free (except the first call on each thread, which creates the ring of the thread).
+        * @param level     Level of the record. Records below the min level are ignored.
+        * @param pszFormat Format string with "{}" placeholders. Must outlive the logger.
+        * @param args      Arguments for the placeholders.
+        * @return False if the record has been dropped due to full ring, or being bigger than half of the ring. True otherwise.
+        */
+        template <typename... Args>
+        bool log(LogLevel level, const char* pszFormat, const Args&... args)
+        {
+            static_assert(sizeof...(Args) <= 255, "Too many log arguments!");
+
+            if (static_cast<uint8_t>(level) < m_nMinLevel.load(std::memory_order_relaxed))
+            {
+                return true;
+            }
+
+            const size_t nSize = sizeof(RecordHeader) + detail::sumLogArgSizes(args...);
+            Ring* pRing;
+            uint64_t nEndPos;
+            char* pDst = beginRecord(nSize, pRing, nEndPos);
+            if (!pDst)
+            {
+                return false;
+            }
+
+            RecordHeader header;
+            header.nSize = static_cast<uint32_t>(alignRecordSize(nSize));
+            header.nLevel = static_cast<uint8_t>(level);
+            header.nArgs = static_cast<uint8_t>(sizeof...(Args));
+            header.nReserved = 0;
+            header.pszFormat = pszFormat;
+            header.nTimestampUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            std::memcpy(pDst, &header, sizeof(header));
+            pDst += sizeof(header);
+            detail::writeLogArgs(pDst, args...);
+
+            // publish the record to the background thread
+            pRing->nWritePos.store(nEndPos, std::memory_order_release);
+            return true;
+        }
+
+        template <typename... Args>
+        bool debug(const char* pszFormat, const Args&... args)
+        {
+            return log(LogLevel::Debug, pszFormat, args...);
+        }
+
+        template <typename... Args>
+        bool info(const char* pszFormat, const Args&... args)
+        {
+            return log(LogLevel::Info, pszFormat, args...);
+        }
+
+        template <typename... Args>
+        bool warning(const char* pszFormat, const Args&... args)
+        {
+            return log(LogLevel::Warning, pszFormat, args...);
+        }
+
+        template <typename... Args>
+        bool error(const char* pszFormat, const Args&... args)
+        {
+            return log(LogLevel::Error, pszFormat, args...);
+        }
+
+        void flush();                      /**< Blocks until all records logged before the call are passed to the sink. */
+
+        void setMinLevel(LogLevel level)
+        {
+            m_nMinLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+        }
+
+        LogLevel getMinLevel() const
+        {
+            return static_cast<LogLevel>(m_nMinLevel.load(std::memory_order_relaxed));
+        }
+
+        /**
+        * @return Number of records dropped due to full ring, or being bigger than half of the ring.
+        */
+        uint64_t getDroppedCount() const
+        {
+            return m_nDropped.load(std::memory_order_relaxed);
+        }
+
+        size_t getRingCapacity() const
+        {
+            return m_nRingCapacity;
+        }
+
+    private:
+
+        struct RecordHeader
+        {
+            uint32_t nSize;            /**< Size of the whole record including this header, multiple of 8. */
+            uint8_t nLevel;
+            uint8_t nArgs;
+            uint16_t nReserved;
+            const char* pszFormat;     /**< Null for padding records filling the end of the ring before wrapping around. */
+            int64_t nTimestampUs;      /**< Microseconds since epoch, system clock. */
+        };
+
+        /**
+        * Single-producer single-consumer byte ring. Positions increase monotonically, and are taken modulo capacity.
+        * Each position is on its own cache line, together with the other side's cached copy of it.
+        */
+        struct Ring
+        {
+            std::thread::id threadId;
+            size_t nIndex;                              /**< Index in m_rings, printed as thread identifier. */
+            std::unique_ptr<uint64_t[]> buffer;         /**< Record data, uint64_t for 8-byte alignment. */
+            char padding0[64];
+            std::atomic<uint64_t> nWritePos;            /**< Written by the producer. */
+            uint64_t nCachedReadPos;                    /**< Producer's copy of nReadPos. */
+            char padding1[64];
+            std::atomic<uint64_t> nReadPos;             /**< Written by the consumer. */
+            char padding2[64];
+        };
+
+        struct LocalRingCacheEntry
+        {
+            uint64_t nLoggerId;
+            Ring* pRing;
+        };
+
+        static constexpr size_t LocalRingCacheSize = 4;
+
+        /** Rings of the current thread in the most recently used loggers. Keyed by logger id, not by address, which could be reused. */
+        static thread_local LocalRingCacheEntry s_localRingCache[LocalRingCacheSize];
+
+        const uint64_t m_nId;
+        const size_t m_nRingCapacity;
+        const LogFullPolicy m_policy;
+        const std::chrono::milliseconds m_pollInterval;
+        Sink m_sink;
+        FILE* m_pFile = nullptr;
+        std::atomic<uint8_t> m_nMinLevel;
+        std::atomic<uint64_t> m_nDropped;
+
+        mutable std::mutex m_mutex;         /**< Guards m_rings, m_bStop and the flush counters. */
+        std::condition_variable m_cv;       /**< Wakes up the background thread. */
+        std::condition_variable m_flushCv;  /**< Signaled by the background thread when a flush is done. */
+        std::vector<std::unique_ptr<Ring>> m_rings;
+        bool m_bStop = false;
+        uint64_t m_nFlushRequested = 0;
+        uint64_t m_nFlushDone = 0;
+        std::thread m_thread;
+
+        // used only by the background thread: date and time of the last formatted record, down to seconds
+        int64_t m_nLastFormattedSecond = -1;
+        char m_szLastFormattedSecond[32];
+
+        static size_t alignRecordSize(size_t nSize)
+        {
+            return (nSize + 7) & ~static_cast<size_t>(7);
+        }
+
+        Ring* localRing()
+        {
+            for (size_t i = 0; i < LocalRingCacheSize; i++)
+            {
+                if (s_localRingCache[i].nLoggerId == m_nId)
+                {
+                    return s_localRingCache[i].pRing;
+                }
+            }
+            return localRingSlow();
+        }
+
+        void init(Sink sink);
+        Ring* localRingSlow();
+        char* beginRecord(size_t nSize, Ring*& pRing, uint64_t& nEndPos);
+        void run();
+        void drainRing(Ring& ring, std::string& sBatch);
+        void formatRecord(const Ring& ring, const char* pRecord, std::string& sBatch);
+
+    }; // class AsyncLogger
+
+} // namespace
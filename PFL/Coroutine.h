@@ -0,0 +1,501 @@
+#pragma once
+
+/*
+    ###################################################################################
+    Coroutine.h
+    Coroutine tasks with timer and next-frame awaitables, driven by a single-threaded per-frame scheduler.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#if __cplusplus < 202002L
+#error "Coroutine.h requires C++20!"
+#endif
+
+#include <cassert>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "PFL.h"
+
+namespace pfl
+{
+    class CoroutineScheduler;
+
+    /**
+    * Coroutine return type for gameplay scripts and other code spanning multiple frames.
+    * A Task does not start running when called: it is started either by CoroutineScheduler::spawn(), or by being co_awaited from
+    * another Task, in which case the awaiting Task continues when the awaited one has finished, and exceptions propagate to it.
+    *
+    * Example:
+    * @code
+    * pfl::Task blink(Light& light)
+    * {
+    *     for (int i = 0; i < 3; i++)
+    *     {
+    *         light.toggle();
+    *         co_await pfl::sleep_for(250000);
+    *     }
+    *     co_await pfl::next_frame();
+    * }
+    * scheduler.spawn(blink(light));
+    * @endcode
+    */
+    class Task
+    {
+
+    public:
+
+        struct promise_type
+        {
+            CoroutineScheduler* pScheduler = nullptr;
+            std::coroutine_handle<> continuation;  /**< The awaiting Task, null for tasks spawned on the scheduler. */
+            std::exception_ptr exception;
+            promise_type* pPrevSpawned = nullptr;  /**< Intrusive list of spawned tasks owned by the scheduler. */
+            promise_type* pNextSpawned = nullptr;
+
+            Task get_return_object() noexcept
+            {
+                return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            struct FinalAwaiter
+            {
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept;
+
+                void await_resume() noexcept
+                {
+                }
+            };
+
+            FinalAwaiter final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void() noexcept
+            {
+            }
+
+            void unhandled_exception() noexcept
+            {
+                exception = std::current_exception();
+            }
+        };
+
+        typedef std::coroutine_handle<promise_type> Handle;
+
+        Task() = default;
+
+        ~Task()
+        {
+            if (m_handle)
+            {
+                m_handle.destroy();
+            }
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        Task(Task&& other) noexcept :
+            m_handle(std::exchange(other.m_handle, nullptr))
+        {
+        }
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (m_handle)
+                {
+                    m_handle.destroy();
+                }
+                m_handle = std::exchange(other.m_handle, nullptr);
+            }
+            return *this;
+        }
+
+        /**
+        * @return True if the coroutine has finished, or this Task is empty.
+        */
+        bool done() const noexcept
+        {
+            return !m_handle || m_handle.done();
+        }
+
+        /**
+        * Runs this Task as a child of the awaiting Task. Exception thrown by the child is rethrown in the awaiting Task.
+        */
+        auto operator co_await() && noexcept
+        {
+            struct Awaiter
+            {
+                Handle child;
+
+                bool await_ready() noexcept
+                {
+                    return !child || child.done();
+                }
+
+                std::coroutine_handle<> await_suspend(Handle parent) noexcept
+                {
+                    child.promise().continuation = parent;
+                    child.promise().pScheduler = parent.promise().pScheduler;
+                    return child;  // symmetric transfer: starts the child without growing the stack
+                }
+
+                void await_resume()
+                {
+                    if (child && child.promise().exception)
+                    {
+                        std::rethrow_exception(child.promise().exception);
+                    }
+                }
+            };
+            return Awaiter{ m_handle };
+        }
+
+    private:
+        friend class CoroutineScheduler;
+
+        Handle m_handle;
+
+        explicit Task(Handle handle) noexcept :
+            m_handle(handle)
+        {
+        }
+
+        Handle release() noexcept
+        {
+            return std::exchange(m_handle, nullptr);
+        }
+
+    }; // class Task
+
+    /**
+    * Single-threaded scheduler of Task coroutines, to be updated once per frame.
+    *
+    * Sleeping coroutines are kept in a min-heap keyed by wake time, so an update resumes only the coroutines that are due,
+    * instead of every object polling the clock. Coroutines waiting for the next frame are resumed at the next update.
+    *
+    * Time is measured in microseconds since construction of the scheduler. update() reads it with PFL::gettimeofday(), or it can be given
+    * explicitly, e.g. to drive scripts by game time. Wake times are relative to the time of the current or last update, so all
+    * coroutines sleeping for the same duration in the same frame wake up in the same frame.
+    *
+    * Spawned tasks are owned by the scheduler and destroyed when finished or when the scheduler is destroyed.
+    */
+    class CoroutineScheduler
+    {
+
+    public:
+
+        CoroutineScheduler()
+        {
+            PFL::gettimeofday(&m_timeStart, nullptr);
+        }
+
+        ~CoroutineScheduler()
+        {
+            while (m_pSpawned)
+            {
+                Task::promise_type* const pPromise = m_pSpawned;
+                unlinkSpawned(pPromise);
+                Task::Handle::from_promise(*pPromise).destroy();
+            }
+        }
+
+        CoroutineScheduler(const CoroutineScheduler&) = delete;
+        CoroutineScheduler& operator=(const CoroutineScheduler&) = delete;
+        CoroutineScheduler(CoroutineScheduler&&) = delete;
+        CoroutineScheduler& operator=(CoroutineScheduler&&) = delete;
+
+        /**
+        * Takes ownership of the given task and runs it until its first suspension.
+        * Exception thrown by the task is rethrown here or by the update() in which it is thrown.
+        */
+        void spawn(Task task)
+        {
+            Task::Handle handle = task.release();
+            if (!handle)
+            {
+                return;
+            }
+
+            Task::promise_type& promise = handle.promise();
+            promise.pScheduler = this;
+            promise.pNextSpawned = m_pSpawned;
+            if (m_pSpawned)
+            {
+                m_pSpawned->pPrevSpawned = &promise;
+            }
+            m_pSpawned = &promise;
+            m_nSpawned++;
+
+            handle.resume();
+            destroyFinished();
+        }
+
+        /**
+        * Resumes coroutines waiting for the next frame, then coroutines whose sleep has expired by now.
+        * To be invoked once per frame.
+        */
+        void update()
+        {
+            update(elapsedUs());
+        }
+
+        /**
+        * Same as update() but with the given time.
+        *
+        * @param nNowUs Time in microseconds on the same scale as previous updates. Not expected to decrease.
+        */
+        void update(int64_t nNowUs)
+        {
+            m_nNowUs = nNowUs;
+
+            // coroutines awaiting next_frame() again during this update shall wait for the next update
+            m_resumeBuffer.clear();
+            m_resumeBuffer.swap(m_nextFrame);
+            for (const std::coroutine_handle<> handle : m_resumeBuffer)
+            {
+                handle.resume();
+            }
+
+            // sleeps started during this update end later than now, so this loop terminates
+            while (!m_sleepers.empty() && (m_sleepers.top().nWakeUs <= m_nNowUs))
+            {
+                const std::coroutine_handle<> handle = m_sleepers.top().handle;
+                m_sleepers.pop();
+                handle.resume();
+            }
+
+            destroyFinished();
+        }
+
+        /**
+        * @return Time of the current or last update in microseconds.
+        */
+        int64_t now() const
+        {
+            return m_nNowUs;
+        }
+
+        /**
+        * @return Microseconds elapsed since construction of the scheduler, measured by PFL::gettimeofday().
+        */
+        int64_t elapsedUs() const
+        {
+            PFL::timeval timeNow;
+            PFL::gettimeofday(&timeNow, nullptr);
+            // PFL::getTimeDiffInUs() is not used as its long result overflows after 35 minutes where long is 32-bit
+            return static_cast<int64_t>(timeNow.tv_sec - m_timeStart.tv_sec) * 1000000 + (timeNow.tv_usec - m_timeStart.tv_usec);
+        }
+
+        /**
+        * @return Number of spawned tasks not yet finished.
+        */
+        size_t size() const
+        {
+            return m_nSpawned;
+        }
+
+        /**
+        * @return Number of coroutines sleeping.
+        */
+        size_t numSleeping() const
+        {
+            return m_sleepers.size();
+        }
+
+        // used by the awaitables
+        void addSleeper(std::coroutine_handle<> handle, int64_t nDurationUs)
+        {
+            if (nDurationUs <= 0)
+            {
+                addNextFrame(handle);
+                return;
+            }
+            m_sleepers.push(Sleeper{ m_nNowUs + nDurationUs, m_nSleepSequence++, handle });
+        }
+
+        void addNextFrame(std::coroutine_handle<> handle)
+        {
+            m_nextFrame.push_back(handle);
+        }
+
+        void onSpawnedFinished(Task::Handle handle)
+        {
+            m_finished.push_back(handle);
+        }
+
+    private:
+
+        struct Sleeper
+        {
+            int64_t nWakeUs;
+            uint64_t nSequence;  /**< Keeps coroutines with the same wake time in FIFO order. */
+            std::coroutine_handle<> handle;
+
+            bool operator>(const Sleeper& other) const
+            {
+                return (nWakeUs != other.nWakeUs) ? (nWakeUs > other.nWakeUs) : (nSequence > other.nSequence);
+            }
+        };
+
+        PFL::timeval m_timeStart;
+        int64_t m_nNowUs = 0;
+        std::priority_queue<Sleeper, std::vector<Sleeper>, std::greater<Sleeper>> m_sleepers;
+        uint64_t m_nSleepSequence = 0;
+        std::vector<std::coroutine_handle<>> m_nextFrame;
+        std::vector<std::coroutine_handle<>> m_resumeBuffer;  /**< Kept as member to reuse its capacity. */
+        std::vector<Task::Handle> m_finished;
+        Task::promise_type* m_pSpawned = nullptr;           /**< Head of the list of spawned tasks. */
+        size_t m_nSpawned = 0;
+
+        void unlinkSpawned(Task::promise_type* pPromise)
+        {
+            if (pPromise->pPrevSpawned)
+            {
+                pPromise->pPrevSpawned->pNextSpawned = pPromise->pNextSpawned;
+            }
+            else
+            {
+                m_pSpawned = pPromise->pNextSpawned;
+            }
+            if (pPromise->pNextSpawned)
+            {
+                pPromise->pNextSpawned->pPrevSpawned = pPromise->pPrevSpawned;
+            }
+            pPromise->pPrevSpawned = nullptr;
+            pPromise->pNextSpawned = nullptr;
+            m_nSpawned--;
+        }
+
+        /**
+        * Destroys spawned tasks that have finished, and rethrows the first exception thrown by any of them.
+        */
+        void destroyFinished()
+        {
+            std::exception_ptr exception;
+            for (const Task::Handle handle : m_finished)
+            {
+                if (!exception)
+                {
+                    exception = handle.promise().exception;
+                }
+                unlinkSpawned(&handle.promise());
+                handle.destroy();
+            }
+            m_finished.clear();
+
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+
+    }; // class CoroutineScheduler
+
+    inline std::coroutine_handle<> Task::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> h) noexcept
+    {
+        promise_type& promise = h.promise();
+        if (promise.continuation)
+        {
+            return promise.continuation;
+        }
+        if (promise.pScheduler)
+        {
+            // cannot destroy itself here, the scheduler does it after resume() returns
+            promise.pScheduler->onSpawnedFinished(h);
+        }
+        return std::noop_coroutine();
+    }
+
+    /**
+    * Awaitable suspending the awaiting Task for the given duration.
+    */
+    struct SleepAwaiter
+    {
+        int64_t nDurationUs;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(Task::Handle handle) const
+        {
+            assert(handle.promise().pScheduler && "Task is not running on a scheduler!");
+            handle.promise().pScheduler->addSleeper(handle, nDurationUs);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    /**
+    * Awaitable suspending the awaiting Task until the next update of its scheduler.
+    */
+    struct NextFrameAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(Task::Handle handle) const
+        {
+            assert(handle.promise().pScheduler && "Task is not running on a scheduler!");
+            handle.promise().pScheduler->addNextFrame(handle);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    /**
+    * @return Awaitable suspending the awaiting Task for the given number of microseconds.
+    *         The Task is resumed by the first update at or after the wake time. Non-positive duration is the same as next_frame().
+    */
+    inline SleepAwaiter sleep_for(int64_t nDurationUs) noexcept
+    {
+        return SleepAwaiter{ nDurationUs };
+    }
+
+    template <typename Rep, typename Period>
+    SleepAwaiter sleep_for(const std::chrono::duration<Rep, Period>& duration) noexcept
+    {
+        return SleepAwaiter{ static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) };
+    }
+
+    /**
+    * @return Awaitable suspending the awaiting Task until the next update of its scheduler.
+    */
+    inline NextFrameAwaiter next_frame() noexcept
+    {
+        return NextFrameAwaiter{};
+    }
+
+} // namespace
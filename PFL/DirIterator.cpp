@@ -0,0 +1,513 @@
+/*
+    ###################################################################################
+    DirIterator.cpp
+    Streaming directory enumeration without per-entry stat, and parallel recursive directory walk.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include "DirIterator.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FixFIFO.h"
+
+#ifdef _WIN32
+#include "winproof88.h"
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <dirent.h>  // DT_* constants
+#else
+#include <dirent.h>
+#endif
+
+
+namespace
+{
+#ifdef _WIN32
+    const char PathDelimiter = '\\';
+#else
+    const char PathDelimiter = '/';
+#endif
+
+    inline bool isDotOrDotDot(const char* name)
+    {
+        return (name[0] == '.') && ((name[1] == '\0') || ((name[1] == '.') && (name[2] == '\0')));
+    }
+
+#if !defined(_WIN32)
+    pfl::DirEntryType typeFromDType(unsigned char dtype)
+    {
+        switch (dtype)
+        {
+        case DT_REG: return pfl::DirEntryType::File;
+        case DT_DIR: return pfl::DirEntryType::Directory;
+        case DT_LNK: return pfl::DirEntryType::Symlink;
+        case DT_UNKNOWN: return pfl::DirEntryType::Unknown;
+        default: return pfl::DirEntryType::Other;
+        }
+    }
+#endif
+
+#ifdef __linux__
+    /**
+        Layout of records returned by the getdents64 syscall.
+        Declared here since older glibc versions have no wrapper for the syscall.
+    */
+    struct LinuxDirent64
+    {
+        uint64_t       d_ino;
+        int64_t        d_off;
+        unsigned short d_reclen;
+        unsigned char  d_type;
+        char           d_name[1];
+    };
+#endif
+
+    /**
+        Lists the given directory for DirIterator::walk(): reports entries via callback and collects subdirectory paths.
+        The given iterator is reused so its buffer is allocated only once per thread.
+    */
+    void walkDirectory(
+        pfl::DirIterator& it,
+        const std::string& sDir,
+        const pfl::DirIterator::WalkCallback& callback,
+        const char* ext,
+        std::vector<std::string>& subDirs,
+        std::atomic<size_t>& nReported)
+    {
+        if (!it.open(sDir.c_str()))
+        {
+            return;
+        }
+
+        pfl::DirEntry entry;
+        while (it.next(entry))
+        {
+            if (entry.type == pfl::DirEntryType::Directory)
+            {
+                subDirs.push_back(sDir);
+                if (sDir.empty() || ((sDir.back() != '/') && (sDir.back() != '\\')))
+                {
+                    subDirs.back() += PathDelimiter;
+                }
+                subDirs.back().append(entry.name, entry.nNameLength);
+                if (ext)
+                {
+                    continue;
+                }
+            }
+            else if (ext && !pfl::DirIterator::hasExtension(entry.name, entry.nNameLength, ext))
+            {
+                continue;
+            }
+
+            callback(sDir, entry);
+            nReported.fetch_add(1, std::memory_order_relaxed);
+        }
+        it.close();
+    }
+
+} // namespace
+
+
+struct pfl::DirIterator::Impl
+{
+#ifdef _WIN32
+    HANDLE hFind = INVALID_HANDLE_VALUE;
+    WIN32_FIND_DATAA findData;
+    bool bPending = false;    /**< True if findData holds an entry not yet returned by next(). */
+#elif defined(__linux__)
+    int fd = -1;
+    std::unique_ptr<char[]> buffer;
+    size_t nLen = 0;          /**< Number of valid bytes in buffer. */
+    size_t nPos = 0;          /**< Offset of the next record in buffer. */
+#else
+    DIR* pDir = nullptr;
+#endif
+};
+
+
+// ############################### PUBLIC ################################
+
+
+pfl::DirIterator::DirIterator() :
+    m_pImpl(new Impl())
+{
+}
+
+
+pfl::DirIterator::~DirIterator()
+{
+    close();
+}
+
+
+/**
+    Starts iterating over the given directory.
+    Any previously opened directory is closed first.
+
+    @return True on success, false if the directory cannot be opened.
+*/
+bool pfl::DirIterator::open(const char* path)
+{
+    close();
+
+#ifdef _WIN32
+    std::string sPattern = path;
+    if (!sPattern.empty() && (sPattern.back() != '/') && (sPattern.back() != '\\'))
+    {
+        sPattern += '\\';
+    }
+    sPattern += '*';
+    // FindExInfoBasic skips the short 8.3 name, FIND_FIRST_EX_LARGE_FETCH asks for bigger batches from the file system
+    m_pImpl->hFind = FindFirstFileExA(
+        sPattern.c_str(), FindExInfoBasic, &m_pImpl->findData, FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+    m_pImpl->bPending = (m_pImpl->hFind != INVALID_HANDLE_VALUE);
+    return m_pImpl->bPending;
+#elif defined(__linux__)
+    m_pImpl->fd = ::open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (m_pImpl->fd < 0)
+    {
+        return false;
+    }
+    if (!m_pImpl->buffer)
+    {
+        m_pImpl->buffer.reset(new char[BufferSize]);
+    }
+    m_pImpl->nLen = 0;
+    m_pImpl->nPos = 0;
+    return true;
+#else
+    m_pImpl->pDir = opendir(path);
+    return m_pImpl->pDir != nullptr;
+#endif
+} // open()
+
+
+/**
+    Stops iterating and releases the directory.
+*/
+void pfl::DirIterator::close()
+{
+#ifdef _WIN32
+    if (m_pImpl->hFind != INVALID_HANDLE_VALUE)
+    {
+        FindClose(m_pImpl->hFind);
+        m_pImpl->hFind = INVALID_HANDLE_VALUE;
+    }
+    m_pImpl->bPending = false;
+#elif defined(__linux__)
+    if (m_pImpl->fd >= 0)
+    {
+        ::close(m_pImpl->fd);
+        m_pImpl->fd = -1;
+    }
+    // buffer is kept for the next open()
+#else
+    if (m_pImpl->pDir)
+    {
+        closedir(m_pImpl->pDir);
+        m_pImpl->pDir = nullptr;
+    }
+#endif
+} // close()
+
+
+/**
+    @return True if a directory is being iterated, false otherwise.
+*/
+bool pfl::DirIterator::isOpen() const
+{
+#ifdef _WIN32
+    return m_pImpl->hFind != INVALID_HANDLE_VALUE;
+#elif defined(__linux__)
+    return m_pImpl->fd >= 0;
+#else
+    return m_pImpl->pDir != nullptr;
+#endif
+} // isOpen()
+
+
+/**
+    Gets the next entry of the directory.
+    Order of entries is the order the file system returns them, it is not sorted.
+
+    @param entry Receives the next entry. Its name is valid until the next call to next() or close().
+
+    @return True if an entry is returned, false if there are no more entries or an error happened.
+*/
+bool pfl::DirIterator::next(DirEntry& entry)
+{
+#ifdef _WIN32
+    while (m_pImpl->bPending || ((m_pImpl->hFind != INVALID_HANDLE_VALUE) && FindNextFileA(m_pImpl->hFind, &m_pImpl->findData)))
+    {
+        m_pImpl->bPending = false;
+        const WIN32_FIND_DATAA& data = m_pImpl->findData;
+        if (isDotOrDotDot(data.cFileName))
+        {
+            continue;
+        }
+
+        entry.name = data.cFileName;
+        entry.nNameLength = strlen(data.cFileName);
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
+        {
+            entry.type = DirEntryType::Symlink;
+        }
+        else if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+            entry.type = DirEntryType::Directory;
+        }
+        else
+        {
+            entry.type = DirEntryType::File;
+        }
+        return true;
+    }
+    return false;
+#elif defined(__linux__)
+    if (m_pImpl->fd < 0)
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        if (m_pImpl->nPos >= m_pImpl->nLen)
+        {
+            const long nRead = syscall(SYS_getdents64, m_pImpl->fd, m_pImpl->buffer.get(), BufferSize);
+            if (nRead <= 0)
+            {
+                return false;
+            }
+            m_pImpl->nLen = static_cast<size_t>(nRead);
+            m_pImpl->nPos = 0;
+        }
+
+        const LinuxDirent64* const pDirent = reinterpret_cast<const LinuxDirent64*>(m_pImpl->buffer.get() + m_pImpl->nPos);
+        m_pImpl->nPos += pDirent->d_reclen;
+        if (isDotOrDotDot(pDirent->d_name))
+        {
+            continue;
+        }
+
+        entry.name = pDirent->d_name;
+        entry.nNameLength = strlen(pDirent->d_name);
+        entry.type = typeFromDType(pDirent->d_type);
+        if (entry.type == DirEntryType::Unknown)
+        {
+            // some file systems do not fill d_type, only then we pay for a stat
+            struct stat st;
+            if (fstatat(m_pImpl->fd, pDirent->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0)
+            {
+                entry.type = S_ISREG(st.st_mode) ? DirEntryType::File :
+                    S_ISDIR(st.st_mode) ? DirEntryType::Directory :
+                    S_ISLNK(st.st_mode) ? DirEntryType::Symlink :
+                    DirEntryType::Other;
+            }
+        }
+        return true;
+    }
+#else
+    if (!m_pImpl->pDir)
+    {
+        return false;
+    }
+
+    while (const struct dirent* const pDirent = readdir(m_pImpl->pDir))
+    {
+        if (isDotOrDotDot(pDirent->d_name))
+        {
+            continue;
+        }
+
+        entry.name = pDirent->d_name;
+        entry.nNameLength = strlen(pDirent->d_name);
+        entry.type = typeFromDType(pDirent->d_type);
+        return true;
+    }
+    return false;
+#endif
+} // next()
+
+
+/**
+    Checks the extension of the given name case-insensitively, without allocating.
+
+    @param name        Name of the entry, e.g. DirEntry::name.
+    @param nNameLength Length of name.
+    @param ext         The extension without the dot, e.g. "png".
+
+    @return True if name ends with a dot followed by ext, false otherwise.
+*/
+bool pfl::DirIterator::hasExtension(const char* name, size_t nNameLength, const char* ext)
+{
+    const size_t nExtLength = strlen(ext);
+    if (nNameLength <= nExtLength)
+    {
+        return false;
+    }
+
+    const char* const pNameExt = name + (nNameLength - nExtLength);
+    if (pNameExt[-1] != '.')
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < nExtLength; i++)
+    {
+        char c1 = pNameExt[i];
+        char c2 = ext[i];
+        c1 = ((c1 >= 'A') && (c1 <= 'Z')) ? static_cast<char>(c1 - 'A' + 'a') : c1;
+        c2 = ((c2 >= 'A') && (c2 <= 'Z')) ? static_cast<char>(c2 - 'A' + 'a') : c2;
+        if (c1 != c2)
+        {
+            return false;
+        }
+    }
+    return true;
+} // hasExtension()
+
+
+/**
+    Recursively walks the given directory.
+    Symbolic links to directories are reported but not followed.
+
+    With more than 1 thread, directories are distributed among threads via a bounded work queue. A thread finding a subdirectory
+    when the queue is full lists that subdirectory itself, so the walk never blocks on the queue.
+    The calling thread also takes part in the walk. The callback is invoked concurrently from multiple threads in this case,
+    and must not throw.
+
+    @param path           The directory to be walked.
+    @param callback       Invoked for each reported entry.
+    @param ext            If nullptr, all entries are reported, including directories.
+                          Otherwise only non-directory entries having this extension (without the dot) are reported, see hasExtension().
+    @param nThreads       Number of threads to be used, including the calling thread. 0 is treated as 1.
+    @param nQueueCapacity Capacity of the work queue of directories. Used only if nThreads is greater than 1. 0 is treated as 1.
+
+    @return Number of reported entries.
+*/
+size_t pfl::DirIterator::walk(
+    const char* path,
+    const WalkCallback& callback,
+    const char* ext,
+    size_t nThreads,
+    size_t nQueueCapacity)
+{
+    std::atomic<size_t> nReported(0);
+
+    if (nThreads <= 1)
+    {
+        DirIterator it;
+        std::vector<std::string> dirs;
+        dirs.push_back(path);
+        while (!dirs.empty())
+        {
+            const std::string sDir = std::move(dirs.back());
+            dirs.pop_back();
+            walkDirectory(it, sDir, callback, ext, dirs, nReported);
+        }
+        return nReported.load();
+    }
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    pfl::FixFIFO<std::string> queue(nQueueCapacity ? nQueueCapacity : 1);
+    size_t nBusy = 0;  // number of threads currently listing directories, guarded by mtx
+    queue.push_back(path);
+
+    const auto worker = [&]()
+    {
+        DirIterator it;
+        std::vector<std::string> localDirs;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&]() { return !queue.empty() || (nBusy == 0); });
+                if (queue.empty())
+                {
+                    // nobody is busy and nothing is queued: no more directories can appear
+                    return;
+                }
+                localDirs.push_back(queue.pop_front());
+                nBusy++;
+            }
+
+            std::vector<std::string> subDirs;
+            while (!localDirs.empty())
+            {
+                const std::string sDir = std::move(localDirs.back());
+                localDirs.pop_back();
+                walkDirectory(it, sDir, callback, ext, subDirs, nReported);
+
+                if (!subDirs.empty())
+                {
+                    size_t nShared = 0;
+                    {
+                        std::lock_guard<std::mutex> lock(mtx);
+                        // check for space first, a failed push_back() would still have moved the path away
+                        while (!subDirs.empty() && !queue.full())
+                        {
+                            queue.push_back(std::move(subDirs.back()));
+                            subDirs.pop_back();
+                            nShared++;
+                        }
+                    }
+                    for (size_t i = 0; i < nShared; i++)
+                    {
+                        cv.notify_one();
+                    }
+                    // whatever did not fit into the shared queue is ours
+                    for (auto& sSubDir : subDirs)
+                    {
+                        localDirs.push_back(std::move(sSubDir));
+                    }
+                    subDirs.clear();
+                }
+            }
+
+            bool bDone;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                nBusy--;
+                bDone = (nBusy == 0) && queue.empty();
+            }
+            if (bDone)
+            {
+                cv.notify_all();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads - 1);
+    for (size_t i = 1; i < nThreads; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    return nReported.load();
+} // walk()
+
+
+// ############################## PROTECTED ##############################
+
+
+// ############################### PRIVATE ###############################
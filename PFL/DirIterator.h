@@ -0,0 +1,94 @@
+#pragma once
+
+/*
+    ###################################################################################
+    DirIterator.h
+    Streaming directory enumeration without per-entry stat, and parallel recursive directory walk.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace pfl
+{
+    /**
+    * Type of a directory entry, as reported by the directory listing itself.
+    */
+    enum class DirEntryType : uint8_t
+    {
+        Unknown,
+        File,
+        Directory,
+        Symlink,
+        Other
+    };
+
+    /**
+    * A directory entry returned by DirIterator::next().
+    * The name points into the iterator's internal buffer and is valid only until the next call to next() or close().
+    */
+    struct DirEntry
+    {
+        const char*  name = nullptr;  /**< Null-terminated name of the entry, without directory path. */
+        size_t       nNameLength = 0;
+        DirEntryType type = DirEntryType::Unknown;
+    };
+
+    /**
+    * Lazy iterator over the entries of a single directory.
+    *
+    * On Linux, entries are read in large batches with the getdents64 syscall, and entry types come from d_type, so no stat() is needed
+    * per entry (except on the few file systems not filling d_type). On Windows, FindFirstFile/FindNextFile are used, which also report
+    * the type without extra calls.
+    * The "." and ".." entries are skipped.
+    */
+    class DirIterator
+    {
+
+    public:
+
+        static constexpr size_t BufferSize = 64 * 1024;  /**< Size of the batch buffer for getdents64. */
+
+        /**
+        * Callback for walk(), receiving the directory path (as given to walk() for the root, and joined from entry names below) and the entry.
+        */
+        typedef std::function<void(const std::string& sDir, const DirEntry& entry)> WalkCallback;
+
+        DirIterator();
+        ~DirIterator();
+
+        DirIterator(const DirIterator&) = delete;
+        DirIterator& operator=(const DirIterator&) = delete;
+        DirIterator(DirIterator&&) = delete;
+        DirIterator& operator=(DirIterator&&) = delete;
+
+        bool open(const char* path);    /**< Starts iterating over the given directory. */
+        void close();                   /**< Stops iterating and releases the directory. */
+        bool isOpen() const;            /**< Tells if a directory is being iterated. */
+        bool next(DirEntry& entry);     /**< Gets the next entry of the directory. */
+
+        static bool hasExtension(
+            const char* name, size_t nNameLength, const char* ext);  /**< Checks the extension of the given name case-insensitively, without allocating. */
+
+        static size_t walk(
+            const char* path,
+            const WalkCallback& callback,
+            const char* ext = nullptr,
+            size_t nThreads = 1,
+            size_t nQueueCapacity = 1024);                          /**< Recursively walks the given directory, optionally in parallel. */
+
+    private:
+
+        struct Impl;
+        std::unique_ptr<Impl> m_pImpl;  /**< Platform-specific state, so platform headers are not needed here. */
+
+    }; // class DirIterator
+
+} // namespace
@@ -0,0 +1,584 @@
+/*
+    ###################################################################################
+    FileMetaCache.cpp
+    Cache of file metadata (existence, size, modification time) keyed by normalized path hash.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include "FileMetaCache.h"
+
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include "winproof88.h"
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+
+namespace
+{
+    inline bool isSeparator(char c)
+    {
+        return (c == '/') || (c == '\\');
+    }
+
+    inline char foldCase(char c)
+    {
+#ifdef _WIN32
+        return ((c >= 'A') && (c <= 'Z')) ? static_cast<char>(c - 'A' + 'a') : c;
+#else
+        return c;
+#endif
+    }
+
+    /**
+        Feeds the normalized form of the given path to emit() char by char, so hashing and comparing need no allocation.
+        See FileMetaCache class description for the rules.
+    */
+    template <typename F>
+    void forEachNormalizedChar(const char* path, F&& emit)
+    {
+        const char* p = path;
+        bool bNeedSeparator = false;
+        bool bEmitted = false;
+        if (isSeparator(*p))
+        {
+            emit('/');
+            bEmitted = true;
+        }
+
+        while (*p)
+        {
+            while (isSeparator(*p))
+            {
+                p++;
+            }
+            const char* const pSegment = p;
+            while (*p && !isSeparator(*p))
+            {
+                p++;
+            }
+
+            const size_t nLen = static_cast<size_t>(p - pSegment);
+            if ((nLen == 0) || ((nLen == 1) && (pSegment[0] == '.')))
+            {
+                continue;
+            }
+
+            if (bNeedSeparator)
+            {
+                emit('/');
+            }
+            for (const char* q = pSegment; q != p; q++)
+            {
+                emit(foldCase(*q));
+            }
+            bNeedSeparator = true;
+            bEmitted = true;
+        }
+
+        if (!bEmitted && *path)
+        {
+            // path consisting of "." segments only is the current directory, don't let it collide with the empty path
+            emit('.');
+        }
+    }
+
+    bool equalsNormalized(const std::string& sNormalized, const char* path)
+    {
+        size_t i = 0;
+        bool bEqual = true;
+        forEachNormalizedChar(path, [&](char c)
+            {
+                if (bEqual && (i < sNormalized.size()) && (sNormalized[i] == c))
+                {
+                    i++;
+                }
+                else
+                {
+                    bEqual = false;
+                }
+            });
+        return bEqual && (i == sNormalized.size());
+    }
+
+#ifdef _WIN32
+    int64_t fileTimeToUnixTime(const FILETIME& ft)
+    {
+        // number of 100 nanosecond intervals between January 1, 1601 and January 1, 1970, same as in PFL::gettimeofday()
+        static const uint64_t EPOCH = ((uint64_t) 116444736000000000ULL);
+        const uint64_t time = (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+        return static_cast<int64_t>((time - EPOCH) / 10000000ULL);
+    }
+#endif
+
+    pfl::FileMeta statPath(const char* path)
+    {
+        pfl::FileMeta meta;
+#ifdef _WIN32
+        struct _stat64 st;
+        if (_stat64(path, &st) == 0)
+        {
+            meta.bExists = true;
+            meta.bDirectory = ((st.st_mode & _S_IFMT) == _S_IFDIR);
+            meta.nSize = meta.bDirectory ? 0u : static_cast<uint64_t>(st.st_size);
+            meta.nModifiedTime = static_cast<int64_t>(st.st_mtime);
+        }
+#else
+        struct stat st;
+        if (stat(path, &st) == 0)
+        {
+            meta.bExists = true;
+            meta.bDirectory = S_ISDIR(st.st_mode);
+            meta.nSize = meta.bDirectory ? 0u : static_cast<uint64_t>(st.st_size);
+            meta.nModifiedTime = static_cast<int64_t>(st.st_mtime);
+        }
+#endif
+        return meta;
+    }
+
+    /**
+        Appends metadata of all entries in the given directory to found.
+        Subdirectories are also appended to subDirs if it is not nullptr.
+    */
+    void listDirectory(
+        const std::string& sDir,
+        std::vector<std::pair<std::string, pfl::FileMeta>>& found,
+        std::vector<std::string>* pSubDirs)
+    {
+#ifdef _WIN32
+        WIN32_FIND_DATAA findData;
+        const HANDLE hFind = FindFirstFileA((sDir + "\\*").c_str(), &findData);
+        if (hFind == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+
+        do
+        {
+            const char* const name = findData.cFileName;
+            if ((name[0] == '.') && ((name[1] == '\0') || ((name[1] == '.') && (name[2] == '\0'))))
+            {
+                continue;
+            }
+
+            pfl::FileMeta meta;
+            meta.bExists = true;
+            meta.bDirectory = (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+            meta.nSize = meta.bDirectory ? 0u : ((static_cast<uint64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow);
+            meta.nModifiedTime = fileTimeToUnixTime(findData.ftLastWriteTime);
+
+            found.emplace_back(sDir + '\\' + name, meta);
+            if (meta.bDirectory && pSubDirs)
+            {
+                pSubDirs->push_back(found.back().first);
+            }
+        } while (FindNextFileA(hFind, &findData));
+
+        FindClose(hFind);
+#else
+        DIR* const pDir = opendir(sDir.c_str());
+        if (!pDir)
+        {
+            return;
+        }
+
+        const int fdDir = dirfd(pDir);
+        while (const struct dirent* const pEntry = readdir(pDir))
+        {
+            const char* const name = pEntry->d_name;
+            if ((name[0] == '.') && ((name[1] == '\0') || ((name[1] == '.') && (name[2] == '\0'))))
+            {
+                continue;
+            }
+
+            // relative to the already opened directory, so the kernel does not walk the full path again
+            struct stat st;
+            pfl::FileMeta meta;
+            if (fstatat(fdDir, name, &st, 0) == 0)
+            {
+                meta.bExists = true;
+                meta.bDirectory = S_ISDIR(st.st_mode);
+                meta.nSize = meta.bDirectory ? 0u : static_cast<uint64_t>(st.st_size);
+                meta.nModifiedTime = static_cast<int64_t>(st.st_mtime);
+            }
+
+            found.emplace_back(sDir + '/' + name, meta);
+            if (meta.bDirectory && pSubDirs)
+            {
+                pSubDirs->push_back(found.back().first);
+            }
+        }
+
+        closedir(pDir);
+#endif
+    }
+
+} // namespace
+
+
+// ############################### PUBLIC ################################
+
+
+pfl::FileMetaCache::FileMetaCache()
+{
+#ifdef __linux__
+    // if this fails, we simply don't have automatic invalidation
+    m_fdInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+
+pfl::FileMetaCache::~FileMetaCache()
+{
+#ifdef __linux__
+    if (m_fdInotify >= 0)
+    {
+        close(m_fdInotify);
+    }
+#endif
+}
+
+
+/**
+    Gets metadata of the given path.
+    If the path is not yet cached, it is stat()-ed and the result is cached, even if the path does not exist.
+
+    @return Metadata of the given path.
+*/
+pfl::FileMeta pfl::FileMetaCache::lookup(const char* path)
+{
+    const PFL::StringHash hash = hashPath(path);
+    uint64_t nInvalidations;
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+        const FileMeta* const pMeta = find(hash, path);
+        if (pMeta)
+        {
+            return *pMeta;
+        }
+        nInvalidations = m_nInvalidations;
+    }
+
+    // stat without holding the lock, a concurrent miss on the same path just does the same work
+    const FileMeta meta = statPath(path);
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(m_mutex);
+        // if anything has been invalidated meanwhile, the path might have changed after our stat(), so the result is returned
+        // but not cached, otherwise it would stay cached without any further change notification
+        if ((m_nInvalidations == nInvalidations) && !find(hash, path))
+        {
+            insert(hash, path, meta);
+        }
+    }
+    return meta;
+} // lookup()
+
+
+/**
+    Cached replacement for PFL::fileExists().
+
+    @return True if the given path exists, false otherwise.
+*/
+bool pfl::FileMetaCache::fileExists(const char* path)
+{
+    return lookup(path).bExists;
+} // fileExists()
+
+
+/**
+    Caches metadata of the given directory and all entries in it, replacing earlier cached values.
+    On Linux, the scanned directories are also watched for changes, see pollChanges().
+
+    @param path       The directory to be scanned.
+    @param bRecursive If true, subdirectories are also scanned.
+
+    @return Number of paths cached, including the given directory itself.
+            0 if anything has been invalidated during the scan: then nothing is cached, as any of the results might be stale,
+            but the directories are watched anyway, and paths are cached by lookup() as usual.
+*/
+size_t pfl::FileMetaCache::scanDirectory(const char* path, bool bRecursive)
+{
+    uint64_t nInvalidations;
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+        nInvalidations = m_nInvalidations;
+    }
+
+    std::vector<std::pair<std::string, FileMeta>> found;
+    found.emplace_back(path, statPath(path));
+
+    std::vector<std::string> dirs;
+    if (found.back().second.bDirectory)
+    {
+        dirs.push_back(path);
+    }
+
+    while (!dirs.empty())
+    {
+        const std::string sDir = std::move(dirs.back());
+        dirs.pop_back();
+        // watch first, so changes happening during listing are not lost
+        watchDirectory(sDir, bRecursive);
+        listDirectory(sDir, found, bRecursive ? &dirs : nullptr);
+    }
+
+    std::unique_lock<std::shared_timed_mutex> lock(m_mutex);
+    // same as in lookup(): a change notification processed since we started might be about a path we have already listed
+    if (m_nInvalidations != nInvalidations)
+    {
+        return 0;
+    }
+    for (const auto& entry : found)
+    {
+        const PFL::StringHash hash = hashPath(entry.first.c_str());
+        erase(hash, entry.first.c_str());
+        insert(hash, entry.first.c_str(), entry.second);
+    }
+    return found.size();
+} // scanDirectory()
+
+
+/**
+    Invalidates cached entries of paths changed on disk since the last call, so their next lookup re-stats them.
+    Only paths inside directories scanned by scanDirectory() are tracked, and only on Linux. Elsewhere this function does nothing.
+    Directories created or moved into a recursively scanned directory are scanned by scanDirectory(), so they are tracked too.
+    Does not block, except for scanning new directories: meant to be called regularly, e.g. once per frame.
+
+    @return Number of change notifications processed.
+*/
+size_t pfl::FileMetaCache::pollChanges()
+{
+    size_t nProcessed = 0;
+#ifdef __linux__
+    if (m_fdInotify < 0)
+    {
+        return 0;
+    }
+
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    std::vector<std::string> newDirs;
+    for (;;)
+    {
+        const ssize_t nLen = read(m_fdInotify, buffer, sizeof(buffer));
+        if (nLen <= 0)
+        {
+            // EAGAIN: no more events
+            break;
+        }
+
+        std::unique_lock<std::shared_timed_mutex> lock(m_mutex);
+        m_nInvalidations++;
+        for (const char* p = buffer; p < buffer + nLen; )
+        {
+            const struct inotify_event* const pEvent = reinterpret_cast<const struct inotify_event*>(p);
+            p += sizeof(struct inotify_event) + pEvent->len;
+            nProcessed++;
+
+            if (pEvent->mask & IN_Q_OVERFLOW)
+            {
+                // events were lost, we cannot know what changed
+                m_entries.clear();
+                continue;
+            }
+
+            const auto itDir = m_watchedDirs.find(pEvent->wd);
+            if (itDir == m_watchedDirs.end())
+            {
+                continue;
+            }
+
+            const std::string& sDir = itDir->second.sPath;
+            if (pEvent->len > 0)
+            {
+                const std::string sPath = sDir + '/' + pEvent->name;
+                erase(hashPath(sPath.c_str()), sPath.c_str());
+
+                if ((pEvent->mask & IN_ISDIR) && (pEvent->mask & (IN_CREATE | IN_MOVED_TO)) && itDir->second.bRecursive)
+                {
+                    // content of a new directory is not going to generate events until it is watched
+                    newDirs.push_back(sPath);
+                }
+
+                if ((pEvent->mask & IN_ISDIR) && (pEvent->mask & (IN_DELETE | IN_MOVED_FROM)))
+                {
+                    // entries under a removed or renamed directory are not going to get their own events
+                    const std::string sPrefix = normalizePath(sPath.c_str()) + '/';
+                    for (auto it = m_entries.begin(); it != m_entries.end(); )
+                    {
+                        it = (it->second.sPath.compare(0, sPrefix.size(), sPrefix) == 0) ? m_entries.erase(it) : std::next(it);
+                    }
+                }
+            }
+
+            // directory's own metadata (e.g. modification time) changes together with its content
+            erase(hashPath(sDir.c_str()), sDir.c_str());
+
+            if (pEvent->mask & IN_IGNORED)
+            {
+                m_watchedDirs.erase(itDir);
+            }
+        }
+    }
+
+    // without holding the lock, scanDirectory() takes it
+    for (const std::string& sDir : newDirs)
+    {
+        scanDirectory(sDir.c_str(), true);
+    }
+#endif
+    return nProcessed;
+} // pollChanges()
+
+
+/**
+    Removes the given path from the cache, so its next lookup re-stats it.
+*/
+void pfl::FileMetaCache::invalidate(const char* path)
+{
+    const PFL::StringHash hash = hashPath(path);
+    std::unique_lock<std::shared_timed_mutex> lock(m_mutex);
+    m_nInvalidations++;
+    erase(hash, path);
+} // invalidate()
+
+
+/**
+    Removes all entries from the cache.
+    Directory watches are kept.
+*/
+void pfl::FileMetaCache::clear()
+{
+    std::unique_lock<std::shared_timed_mutex> lock(m_mutex);
+    m_nInvalidations++;
+    m_entries.clear();
+} // clear()
+
+
+/**
+    Gets the number of cached paths.
+*/
+size_t pfl::FileMetaCache::size() const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+    return m_entries.size();
+} // size()
+
+
+/**
+    Calculates hash of the normalized form of the given path, without allocating.
+    Result is the same as PFL::calcHash(normalizePath(path)).
+*/
+PFL::StringHash pfl::FileMetaCache::hashPath(const char* path)
+{
+    PFL::StringHash hash = 5381;
+    forEachNormalizedChar(path, [&hash](char c)
+        {
+            hash = (hash << 5) + hash + static_cast<uint32_t>(c);
+        });
+    return hash;
+} // hashPath()
+
+
+/**
+    Gets the normalized form of the given path, as used for keys.
+*/
+std::string pfl::FileMetaCache::normalizePath(const char* path)
+{
+    std::string sNormalized;
+    forEachNormalizedChar(path, [&sNormalized](char c)
+        {
+            sNormalized += c;
+        });
+    return sNormalized;
+} // normalizePath()
+
+
+// ############################## PROTECTED ##############################
+
+
+// ############################### PRIVATE ###############################
+
+
+/**
+    Caller must hold m_mutex, either shared or unique.
+*/
+const pfl::FileMeta* pfl::FileMetaCache::find(PFL::StringHash hash, const char* path) const
+{
+    const auto range = m_entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (equalsNormalized(it->second.sPath, path))
+        {
+            return &it->second.meta;
+        }
+    }
+    return nullptr;
+} // find()
+
+
+/**
+    Caller must hold m_mutex unique.
+*/
+void pfl::FileMetaCache::insert(PFL::StringHash hash, const char* path, const FileMeta& meta)
+{
+    m_entries.emplace(hash, Entry{ normalizePath(path), meta });
+} // insert()
+
+
+/**
+    Caller must hold m_mutex unique.
+*/
+void pfl::FileMetaCache::erase(PFL::StringHash hash, const char* path)
+{
+    const auto range = m_entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (equalsNormalized(it->second.sPath, path))
+        {
+            m_entries.erase(it);
+            return;
+        }
+    }
+} // erase()
+
+
+void pfl::FileMetaCache::watchDirectory(const std::string& path, bool bRecursive)
+{
+#ifdef __linux__
+    if (m_fdInotify < 0)
+    {
+        return;
+    }
+
+    const int wd = inotify_add_watch(
+        m_fdInotify, path.c_str(),
+        IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF);
+    if (wd >= 0)
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(m_mutex);
+        WatchedDir& dir = m_watchedDirs[wd];
+        dir.sPath = path;
+        // watching a directory again returns the same descriptor, don't lose recursion of an earlier scan
+        dir.bRecursive = dir.bRecursive || bRecursive;
+    }
+#else
+    (void)path;
+    (void)bRecursive;
+#endif
+} // watchDirectory()
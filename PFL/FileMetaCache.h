@@ -0,0 +1,103 @@
+#pragma once
+
+/*
+    ###################################################################################
+    FileMetaCache.h
+    Cache of file metadata (existence, size, modification time) keyed by normalized path hash.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>  // cpp14
+#include <string>
+#include <unordered_map>
+
+#include "PFL.h"
+
+namespace pfl
+{
+    /**
+    * Metadata of a path as cached by FileMetaCache.
+    */
+    struct FileMeta
+    {
+        bool     bExists = false;     /**< True if the path exists, as file or directory. */
+        bool     bDirectory = false;  /**< True if the path exists and is a directory. */
+        uint64_t nSize = 0;           /**< Size in bytes. 0 for directories and non-existing paths. */
+        int64_t  nModifiedTime = 0;   /**< Last modification time, in seconds since the Unix epoch. */
+    };
+
+    /**
+    * Cache of file metadata, to replace repeated stat() calls with hash lookups.
+    *
+    * Paths are normalized before hashing: '/' and '\' are treated the same, duplicate separators, trailing separators and "." segments
+    * are ignored, and on Windows the comparison is case-insensitive. So "Assets\\Maps//a.txt" and "./Assets/Maps/a.txt" are the same key.
+    * ".." segments are kept as they are, there is no lexical resolution.
+    *
+    * The cache can be populated in bulk by scanDirectory(), otherwise each first lookup of a path does a stat() and caches the result,
+    * including negative results.
+    * On Linux, scanned directories are watched with inotify, and pollChanges() invalidates entries of changed paths, so the next lookup
+    * re-stats them. Directories created later inside a recursively scanned directory are scanned and watched by pollChanges().
+    * Paths outside scanned directories, and all paths on other platforms, stay cached until invalidate() or clear().
+    *
+    * All functions are thread-safe. Lookups of cached paths take a shared lock only, so they do not block each other.
+    */
+    class FileMetaCache
+    {
+
+    public:
+
+        FileMetaCache();
+        ~FileMetaCache();
+
+        FileMetaCache(const FileMetaCache&) = delete;
+        FileMetaCache& operator=(const FileMetaCache&) = delete;
+        FileMetaCache(FileMetaCache&&) = delete;
+        FileMetaCache& operator=(FileMetaCache&&) = delete;
+
+        FileMeta lookup(const char* path);                          /**< Gets metadata of the given path, from cache if available. */
+        bool     fileExists(const char* path);                      /**< Cached replacement for PFL::fileExists(). */
+        size_t   scanDirectory(const char* path, bool bRecursive);  /**< Caches metadata of all entries in the given directory. */
+        size_t   pollChanges();                                     /**< Invalidates entries changed on disk since the last poll. */
+        void     invalidate(const char* path);                      /**< Removes the given path from the cache. */
+        void     clear();                                           /**< Removes all entries from the cache. */
+        size_t   size() const;                                      /**< Gets the number of cached paths. */
+
+        static PFL::StringHash hashPath(const char* path);          /**< Calculates hash of the normalized form of the given path. */
+        static std::string     normalizePath(const char* path);     /**< Gets the normalized form of the given path, as used for keys. */
+
+    private:
+
+        struct Entry
+        {
+            std::string sPath;  /**< Normalized path, to resolve hash collisions. */
+            FileMeta meta;
+        };
+
+        mutable std::shared_timed_mutex m_mutex;
+        std::unordered_multimap<PFL::StringHash, Entry> m_entries;
+        uint64_t m_nInvalidations = 0;  /**< Incremented by each invalidation, so lookup() can tell if its stat() result might be stale. */
+
+#ifdef __linux__
+        struct WatchedDir
+        {
+            std::string sPath;
+            bool bRecursive = false;  /**< True if subdirectories are also watched, including the ones created later. */
+        };
+
+        int m_fdInotify = -1;
+        std::unordered_map<int, WatchedDir> m_watchedDirs;  /**< inotify watch descriptor -> directory. */
+#endif
+
+        const FileMeta* find(PFL::StringHash hash, const char* path) const;
+        void insert(PFL::StringHash hash, const char* path, const FileMeta& meta);
+        void erase(PFL::StringHash hash, const char* path);
+        void watchDirectory(const std::string& path, bool bRecursive);
+
+    }; // class FileMetaCache
+
+} // namespace
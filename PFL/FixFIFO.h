@@ -11,6 +11,8 @@
 */
 
 #include <cassert>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace pfl
@@ -110,7 +112,7 @@ namespace pfl
             // since we do "mod m_nCapacity" of course this will be always true but let's leave this here in case someone modifies something!
             assert(m_iEnd <= m_nCapacity);
 
-            m_array[m_iEnd] = elem;
+            m_array[m_iEnd] = std::move(elem);
             m_iEnd = next_index(m_iEnd);
             m_nSize++;
 
@@ -161,7 +163,7 @@ namespace pfl
             // since we do "mod m_nCapacity" of course this will be always true but let's leave this here in case someone modifies something!
             assert(m_iEnd <= m_nCapacity);
         
-            m_array[m_iEnd] = elem;
+            m_array[m_iEnd] = std::move(elem);
             m_iEnd = next_index(m_iEnd);
             m_nSize++;
         }
@@ -183,7 +185,8 @@ namespace pfl
             // since we do "mod m_nCapacity" of course this will be always true but let's leave this here in case someone modifies something!
             assert(m_iBegin <= m_nCapacity);
 
-            T& elem = m_array[m_iBegin];
+            // the slot is not accessible anymore, so its content can be moved out instead of copied
+            T elem = std::move(m_array[m_iBegin]);
             m_iBegin = next_index(m_iBegin);
             m_nSize--;
 
@@ -223,6 +226,25 @@ namespace pfl
             return m_array[m_iBegin];
         }
 
+        /**
+        * Random access to elements in queue order, without popping them.
+        * Complexity: O(1) constant.
+        *
+        * @param n Position of the requested elem in the queue, where 0 is the oldest elem (front()) and size()-1 is the newest elem.
+        *
+        * @return The n-th elem of the queue.
+        *         Throws exception if n is not less than size().
+        */
+        const T& at(const size_t& n) const
+        {
+            if (n >= size())
+            {
+                throw std::out_of_range("Index is out of range!");
+            }
+
+            return m_array[(m_iBegin + n) % m_nCapacity];
+        }
+
         /**
         * Can be used for iterating over underlying_array().
         * See next_index() for more info.
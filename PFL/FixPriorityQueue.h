@@ -0,0 +1,504 @@
+#pragma once
+
+/*
+    ###################################################################################
+    FixPriorityQueue.h
+    Fixed-capacity priority queue (4-ary min-heap) with continuous memory area for element storage and handles for updating elements.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace pfl
+{
+    /**
+    * Handle of an element in a FixPriorityQueue.
+    * Stays valid until the element is popped or erased, after which it is detected as stale, even if the slot has been reused since then.
+    * Default-constructed handle is invalid.
+    */
+    struct FixPriorityQueueHandle
+    {
+        uint32_t index = 0;       /**< Index of the slot. */
+        uint32_t generation = 0;  /**< Generation of the slot when the element was pushed. Never 0 for handles returned by FixPriorityQueue. */
+
+        bool isValid() const
+        {
+            return generation != 0;
+        }
+
+        bool operator==(const FixPriorityQueueHandle& other) const
+        {
+            return (index == other.index) && (generation == other.generation);
+        }
+
+        bool operator!=(const FixPriorityQueueHandle& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    /**
+    * Fixed-capacity priority queue, with continuous memory area (array) for element storage, so it never allocates after construction.
+    *
+    * Unlike std::priority_queue, top() is the least element according to Compare, e.g. the node with the lowest cost in a pathfinding
+    * open set, or the earliest deadline. For a max-queue use std::greater as Compare.
+    *
+    * Elements are kept in a 4-ary heap: a node has 4 children next to each other in memory, so the heap is half as deep as a binary heap,
+    * and finding the least child touches a single cache line for small elements.
+    * Push, pop, update and erase are O(log n).
+    *
+    * An element pushed with a handle can be updated later, e.g. decrease-key when a shorter path to a node is found, or erased.
+    * push_evict() keeps the greatest capacity() elements pushed, e.g. the top-K most important events or packets.
+    *
+    * Not thread-safe.
+    */
+    template <typename T, typename Compare = std::less<T>>
+    class FixPriorityQueue
+    {
+
+    public:
+
+        /**
+        * @param capacity Maximum number of elements to be stored in this queue.
+        *                 Must be positive and less than 2^32-1.
+        *                 Exception is thrown for zero or too big value.
+        * @param compare  Strict weak ordering of elements, top() is the least element.
+        */
+        FixPriorityQueue(const size_t& capacity, const Compare& compare = Compare()) :
+            m_nCapacity(capacity),
+            m_compare(compare)
+        {
+            if (!capacity)
+            {
+                throw std::runtime_error("Capacity must be positive!");
+            }
+            if (capacity >= InvalidIndex)
+            {
+                throw std::runtime_error("Capacity is too big!");
+            }
+
+            m_heap.resize(capacity);
+            m_slots.resize(capacity);
+            linkFreeSlots();
+        }
+
+        ~FixPriorityQueue() = default;
+
+        FixPriorityQueue(const FixPriorityQueue&) = default;
+        FixPriorityQueue& operator=(const FixPriorityQueue&) = default;
+        FixPriorityQueue(FixPriorityQueue&&) = default;
+        FixPriorityQueue& operator=(FixPriorityQueue&&) = default;
+
+        /**
+        * @return Size of the queue.
+        */
+        const size_t& size() const
+        {
+            return m_nSize;
+        }
+
+        /**
+        * @return Capacity of the queue.
+        */
+        const size_t& capacity() const
+        {
+            return m_nCapacity;
+        }
+
+        /**
+        * @return True if the queue is empty, false otherwise.
+        */
+        bool empty() const
+        {
+            return (size() == 0);
+        }
+
+        /**
+        * @return True if the queue is full, false otherwise.
+        */
+        bool full() const
+        {
+            return (size() == capacity());
+        }
+
+        /**
+        * Resets size of the queue to 0 i.e. the queue becomes empty. All existing handles become stale.
+        */
+        void clear()
+        {
+            for (size_t i = 0; i < m_nSize; i++)
+            {
+                bumpGeneration(m_slots[m_heap[i].iSlot]);
+            }
+            m_nSize = 0;
+            linkFreeSlots();
+        }
+
+        /**
+        * Adds the elem to the queue.
+        * Complexity: O(log n).
+        *
+        * @param  elem The new elem to be added to the queue.
+        *
+        * @return True if push actually happened, false if push did not happen due to the queue being full.
+        */
+        bool push(T elem /* by value so copy elision will be done by compiler */)
+        {
+            FixPriorityQueueHandle handle;
+            return push(std::move(elem), handle);
+        }
+
+        /**
+        * Adds the elem to the queue, and gets a handle for updating or erasing it later.
+        * Complexity: O(log n).
+        *
+        * @param  elem   The new elem to be added to the queue.
+        * @param  handle Set to the handle of the new elem, or to an invalid handle if push did not happen.
+        *
+        * @return True if push actually happened, false if push did not happen due to the queue being full.
+        */
+        bool push(T elem, FixPriorityQueueHandle& handle)
+        {
+            if (full())
+            {
+                handle = FixPriorityQueueHandle();
+                return false;
+            }
+
+            const uint32_t iSlot = m_iFreeHead;
+            Slot& slot = m_slots[iSlot];
+            m_iFreeHead = slot.iHeapOrNextFree;
+
+            const size_t i = m_nSize++;
+            m_heap[i].value = std::move(elem);
+            m_heap[i].iSlot = iSlot;
+            slot.iHeapOrNextFree = static_cast<uint32_t>(i);
+            siftUp(i);
+
+            handle.index = iSlot;
+            handle.generation = slot.generation;
+            return true;
+        }
+
+        /**
+        * Bounded top-K push: adds the elem to the queue, evicting the least elem if the queue is full and the new elem is greater.
+        * Pushing all candidates with this keeps the capacity() greatest ones in the queue, and top() is the least of them.
+        * Complexity: O(log n).
+        *
+        * @param  elem The new elem to be added to the queue.
+        *
+        * @return True if the elem has been added, false if the queue is full and the elem is not greater than top().
+        */
+        bool push_evict(T elem)
+        {
+            FixPriorityQueueHandle handle;
+            return push_evict(std::move(elem), handle);
+        }
+
+        /**
+        * Same as push_evict() above, also getting the handle of the new elem. The handle of the evicted elem becomes stale.
+        */
+        bool push_evict(T elem, FixPriorityQueueHandle& handle)
+        {
+            if (!full())
+            {
+                return push(std::move(elem), handle);
+            }
+
+            if (!m_compare(m_heap[0].value, elem))
+            {
+                handle = FixPriorityQueueHandle();
+                return false;
+            }
+
+            // the new elem takes over the slot of the evicted top, with a new generation so old handles become stale
+            const uint32_t iSlot = m_heap[0].iSlot;
+            bumpGeneration(m_slots[iSlot]);
+            m_heap[0].value = std::move(elem);
+            siftDown(0);
+
+            handle.index = iSlot;
+            handle.generation = m_slots[iSlot].generation;
+            return true;
+        }
+
+        /**
+        * Removes the least elem from the queue.
+        * Complexity: O(log n).
+        *
+        * @return The least elem of the queue that has just got removed.
+        *         Throws exception if the queue is empty.
+        */
+        T pop()
+        {
+            if (empty())
+            {
+                throw std::runtime_error("Container is empty!");
+            }
+
+            T elem = std::move(m_heap[0].value);
+            removeAt(0);
+            return elem;
+        }
+
+        /**
+        * Same as pop() but does not return anything.
+        * A bit faster than pop().
+        */
+        void pop_noreturn()
+        {
+            if (empty())
+            {
+                throw std::runtime_error("Container is empty!");
+            }
+
+            removeAt(0);
+        }
+
+        /**
+        * @return The least elem of the queue.
+        *         Throws exception if the queue is empty.
+        */
+        const T& top() const
+        {
+            if (empty())
+            {
+                throw std::runtime_error("Container is empty!");
+            }
+
+            return m_heap[0].value;
+        }
+
+        /**
+        * Replaces the elem referred by the given handle, and restores heap order, e.g. decrease-key in Dijkstra or A*.
+        * The new elem can be less or greater than the old one.
+        * Complexity: O(log n).
+        *
+        * @return True if the elem has been updated, false if the handle is invalid or stale.
+        */
+        bool update(const FixPriorityQueueHandle& handle, T elem)
+        {
+            if (!contains(handle))
+            {
+                return false;
+            }
+
+            const size_t i = m_slots[handle.index].iHeapOrNextFree;
+            const bool bLess = m_compare(elem, m_heap[i].value);
+            m_heap[i].value = std::move(elem);
+            if (bLess)
+            {
+                siftUp(i);
+            }
+            else
+            {
+                siftDown(i);
+            }
+            return true;
+        }
+
+        /**
+        * Removes the elem referred by the given handle.
+        * Complexity: O(log n).
+        *
+        * @return True if the elem was removed, false if the handle is invalid or stale.
+        */
+        bool erase(const FixPriorityQueueHandle& handle)
+        {
+            if (!contains(handle))
+            {
+                return false;
+            }
+
+            removeAt(m_slots[handle.index].iHeapOrNextFree);
+            return true;
+        }
+
+        /**
+        * Tells if the given handle refers to an elem in the queue.
+        * Complexity: O(1) constant.
+        */
+        bool contains(const FixPriorityQueueHandle& handle) const
+        {
+            if ((handle.index >= m_nCapacity) || !handle.isValid())
+            {
+                return false;
+            }
+
+            // a free slot also has a generation, so a handle never returned by push() could match it:
+            // the slot is used only if its heap entry points back to it
+            const Slot& slot = m_slots[handle.index];
+            return (slot.generation == handle.generation) &&
+                (slot.iHeapOrNextFree < m_nSize) &&
+                (m_heap[slot.iHeapOrNextFree].iSlot == handle.index);
+        }
+
+        /**
+        * Complexity: O(1) constant.
+        *
+        * @return Pointer to the elem referred by the given handle, or nullptr if the handle is invalid or stale.
+        *         The pointer is invalidated by any change of the queue. Use update() to change the elem.
+        */
+        const T* get(const FixPriorityQueueHandle& handle) const
+        {
+            return contains(handle) ? &m_heap[m_slots[handle.index].iHeapOrNextFree].value : nullptr;
+        }
+
+        /**
+        * Random access to elements in heap order, without popping them, e.g. for reading all top-K elements.
+        * at(0) is top(), the order of other elements is unspecified.
+        * Complexity: O(1) constant.
+        *
+        * @return The n-th elem of the underlying heap.
+        *         Throws exception if n is not less than size().
+        */
+        const T& at(const size_t& n) const
+        {
+            if (n >= size())
+            {
+                throw std::out_of_range("Index is out of range!");
+            }
+
+            return m_heap[n].value;
+        }
+
+    private:
+        static const uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+        static const size_t Arity = 4;
+
+        struct Entry
+        {
+            T value{};
+            uint32_t iSlot = InvalidIndex;  /**< Slot of the handle of this elem. */
+        };
+
+        struct Slot
+        {
+            uint32_t iHeapOrNextFree = InvalidIndex;  /**< Index into m_heap if used, index of the next free slot if free. */
+            uint32_t generation = 1;
+        };
+
+        size_t m_nCapacity;
+        Compare m_compare;
+        std::vector<Entry> m_heap;  /**< First m_nSize elements form the heap, children of i are at Arity*i+1 .. Arity*i+Arity. */
+        std::vector<Slot> m_slots;
+        size_t m_nSize = 0;
+        uint32_t m_iFreeHead = InvalidIndex;
+
+        static void bumpGeneration(Slot& slot)
+        {
+            slot.generation++;
+            if (slot.generation == 0)
+            {
+                // 0 is reserved for invalid handles
+                slot.generation = 1;
+            }
+        }
+
+        void linkFreeSlots()
+        {
+            for (size_t i = 0; i < m_nCapacity; i++)
+            {
+                m_slots[i].iHeapOrNextFree = (i + 1 < m_nCapacity) ? static_cast<uint32_t>(i + 1) : InvalidIndex;
+            }
+            m_iFreeHead = 0;
+        }
+
+        /**
+        * Moves the entry at position i of the heap to position iTo, updating its slot.
+        */
+        void moveEntry(size_t i, size_t iTo)
+        {
+            m_heap[iTo] = std::move(m_heap[i]);
+            m_slots[m_heap[iTo].iSlot].iHeapOrNextFree = static_cast<uint32_t>(iTo);
+        }
+
+        void siftUp(size_t i)
+        {
+            Entry entry = std::move(m_heap[i]);
+            while (i > 0)
+            {
+                const size_t iParent = (i - 1) / Arity;
+                if (!m_compare(entry.value, m_heap[iParent].value))
+                {
+                    break;
+                }
+                moveEntry(iParent, i);
+                i = iParent;
+            }
+            m_heap[i] = std::move(entry);
+            m_slots[m_heap[i].iSlot].iHeapOrNextFree = static_cast<uint32_t>(i);
+        }
+
+        void siftDown(size_t i)
+        {
+            Entry entry = std::move(m_heap[i]);
+            for (;;)
+            {
+                const size_t iFirstChild = Arity * i + 1;
+                if (iFirstChild >= m_nSize)
+                {
+                    break;
+                }
+                const size_t iEndChild = (iFirstChild + Arity < m_nSize) ? (iFirstChild + Arity) : m_nSize;
+                size_t iLeast = iFirstChild;
+                for (size_t iChild = iFirstChild + 1; iChild < iEndChild; iChild++)
+                {
+                    if (m_compare(m_heap[iChild].value, m_heap[iLeast].value))
+                    {
+                        iLeast = iChild;
+                    }
+                }
+                if (!m_compare(m_heap[iLeast].value, entry.value))
+                {
+                    break;
+                }
+                moveEntry(iLeast, i);
+                i = iLeast;
+            }
+            m_heap[i] = std::move(entry);
+            m_slots[m_heap[i].iSlot].iHeapOrNextFree = static_cast<uint32_t>(i);
+        }
+
+        /**
+        * Removes the entry at position i of the heap, releasing its slot, and moves the last entry into its place.
+        */
+        void removeAt(size_t i)
+        {
+            assert(i < m_nSize);
+
+            Slot& slot = m_slots[m_heap[i].iSlot];
+            bumpGeneration(slot);
+            slot.iHeapOrNextFree = m_iFreeHead;
+            m_iFreeHead = m_heap[i].iSlot;
+
+            const size_t iLast = --m_nSize;
+            if (i == iLast)
+            {
+                return;
+            }
+
+            moveEntry(iLast, i);
+            // the moved entry might belong either above or below
+            if ((i > 0) && m_compare(m_heap[i].value, m_heap[(i - 1) / Arity].value))
+            {
+                siftUp(i);
+            }
+            else
+            {
+                siftDown(i);
+            }
+        }
+
+    }; // class FixPriorityQueue
+
+} // namespace
@@ -0,0 +1,788 @@
+#pragma once
+
+/*
+    ###################################################################################
+    FixedPoint.h
+    Deterministic fixed-point number types with saturating arithmetic and math helpers.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <cstdint>
+#include <limits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>  // _umul128, _udiv128
+#endif
+
+namespace pfl
+{
+    namespace detail
+    {
+        /** 2^32 / (2*PI), converts radians to turns in 2^32 units. */
+        const uint64_t TurnsPerRadianQ32 = 683565276;
+
+        int32_t sinTurn(uint32_t nTurn);  /**< Sine of the given angle in 2^32 units per turn, in Q2.30 format. */
+
+        /**
+        * Exact 64 x 64 -> 128 bit unsigned multiplication.
+        */
+        inline void mulU64(uint64_t a, uint64_t b, uint64_t& hi, uint64_t& lo)
+        {
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+            hi = static_cast<uint64_t>(p >> 64);
+            lo = static_cast<uint64_t>(p);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            lo = _umul128(a, b, &hi);
+#else
+            const uint64_t aLo = a & 0xFFFFFFFFu;
+            const uint64_t aHi = a >> 32;
+            const uint64_t bLo = b & 0xFFFFFFFFu;
+            const uint64_t bHi = b >> 32;
+            const uint64_t p0 = aLo * bLo;
+            const uint64_t p1 = aLo * bHi;
+            const uint64_t p2 = aHi * bLo;
+            const uint64_t nMid = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+            lo = (nMid << 32) | (p0 & 0xFFFFFFFFu);
+            hi = aHi * bHi + (p1 >> 32) + (p2 >> 32) + (nMid >> 32);
+#endif
+        }
+
+        /**
+        * Exact 128 / 64 -> 64 bit unsigned division. hi must be less than d, so the quotient fits in 64 bits.
+        */
+        inline uint64_t divU128(uint64_t hi, uint64_t lo, uint64_t d)
+        {
+#if defined(__SIZEOF_INT128__)
+            return static_cast<uint64_t>(((static_cast<unsigned __int128>(hi) << 64) | lo) / d);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            uint64_t nRemainder;
+            return _udiv128(hi, lo, d, &nRemainder);
+#else
+            uint64_t q = 0;
+            for (int i = 0; i < 64; i++)
+            {
+                const bool bCarry = (hi >> 63) != 0;
+                hi = (hi << 1) | (lo >> 63);
+                lo <<= 1;
+                q <<= 1;
+                if (bCarry || (hi >= d))
+                {
+                    hi -= d;
+                    q |= 1;
+                }
+            }
+            return q;
+#endif
+        }
+
+        /**
+        * Floor of the square root of a 128 bit unsigned number, bit by bit.
+        */
+        inline uint64_t sqrtU128(uint64_t hi, uint64_t lo)
+        {
+            uint64_t nRoot = 0;
+            uint64_t nRemHi = 0;
+            uint64_t nRemLo = 0;
+            for (int i = 0; i < 64; i++)
+            {
+                nRemHi = (nRemHi << 2) | (nRemLo >> 62);
+                nRemLo = (nRemLo << 2) | (hi >> 62);
+                hi = (hi << 2) | (lo >> 62);
+                lo <<= 2;
+                nRoot <<= 1;
+                const uint64_t nTrialHi = nRoot >> 63;
+                const uint64_t nTrialLo = (nRoot << 1) | 1;
+                if ((nRemHi > nTrialHi) || ((nRemHi == nTrialHi) && (nRemLo >= nTrialLo)))
+                {
+                    nRemHi -= nTrialHi + ((nRemLo < nTrialLo) ? 1 : 0);
+                    nRemLo -= nTrialLo;
+                    nRoot |= 1;
+                }
+            }
+            return nRoot;
+        }
+
+        /**
+        * Shifts right by n bits, rounding half up. n can be zero.
+        */
+        inline int64_t roundShiftRight(int64_t v, unsigned n)
+        {
+            return n ? ((v + (static_cast<int64_t>(1) << (n - 1))) >> n) : v;
+        }
+
+        /**
+        * Raw arithmetic of FixedPoint for each raw type.
+        * All functions produce the saturated result, and return false if it has overflowed.
+        * Multiplication and division round to nearest, halfway cases away from zero, so results are symmetric for negated operands.
+        * lerp() and smooth() work on the exact difference of their operands, which might not fit in RawT, so they never overflow.
+        */
+        template <typename RawT>
+        struct FixedPointOps;
+
+        template <>
+        struct FixedPointOps<int32_t>
+        {
+            static bool saturate(int64_t v, int32_t& result)
+            {
+                if (v > std::numeric_limits<int32_t>::max())
+                {
+                    result = std::numeric_limits<int32_t>::max();
+                    return false;
+                }
+                if (v < std::numeric_limits<int32_t>::min())
+                {
+                    result = std::numeric_limits<int32_t>::min();
+                    return false;
+                }
+                result = static_cast<int32_t>(v);
+                return true;
+            }
+
+            static bool add(int32_t a, int32_t b, int32_t& result)
+            {
+                return saturate(static_cast<int64_t>(a) + b, result);
+            }
+
+            static bool sub(int32_t a, int32_t b, int32_t& result)
+            {
+                return saturate(static_cast<int64_t>(a) - b, result);
+            }
+
+            template <unsigned FracBits>
+            static bool mul(int32_t a, int32_t b, int32_t& result)
+            {
+                const int64_t p = static_cast<int64_t>(a) * b;
+                const uint64_t nMag = (p < 0) ? (0 - static_cast<uint64_t>(p)) : static_cast<uint64_t>(p);
+                const int64_t q = static_cast<int64_t>((nMag + (static_cast<uint64_t>(1) << (FracBits - 1))) >> FracBits);
+                return saturate((p < 0) ? -q : q, result);
+            }
+
+            template <unsigned FracBits>
+            static bool div(int32_t a, int32_t b, int32_t& result)
+            {
+                if (b == 0)
+                {
+                    result = (a > 0) ? std::numeric_limits<int32_t>::max() : ((a < 0) ? std::numeric_limits<int32_t>::min() : 0);
+                    return false;
+                }
+                const uint64_t nMagA = static_cast<uint64_t>((a < 0) ? -static_cast<int64_t>(a) : a);
+                const uint64_t nMagB = static_cast<uint64_t>((b < 0) ? -static_cast<int64_t>(b) : b);
+                const int64_t q = static_cast<int64_t>(((nMagA << FracBits) + nMagB / 2) / nMagB);
+                return saturate(((a < 0) != (b < 0)) ? -q : q, result);
+            }
+
+            template <unsigned FracBits>
+            static int32_t sqrt(int32_t a)
+            {
+                return (a <= 0) ? 0 : static_cast<int32_t>(sqrtU128(0, static_cast<uint64_t>(a) << FracBits));
+            }
+
+            template <unsigned FracBits>
+            static uint32_t toTurn(int32_t a)
+            {
+                const uint64_t nMag = static_cast<uint64_t>((a < 0) ? -static_cast<int64_t>(a) : a);
+                const uint32_t nTurn = static_cast<uint32_t>((nMag * TurnsPerRadianQ32) >> FracBits);
+                return (a < 0) ? (0 - nTurn) : nTurn;
+            }
+
+            /** t must be in [0, 2^FracBits]. */
+            template <unsigned FracBits>
+            static int32_t lerp(int32_t a, int32_t b, int32_t t)
+            {
+                const int64_t d = static_cast<int64_t>(b) - a;
+                const uint64_t nMag = static_cast<uint64_t>((d < 0) ? -d : d);
+                const int64_t q = static_cast<int64_t>((nMag * static_cast<uint64_t>(t) + (static_cast<uint64_t>(1) << (FracBits - 1))) >> FracBits);
+                return static_cast<int32_t>(a + ((d < 0) ? -q : q));
+            }
+
+            /** speed must be greater than 2^FracBits. */
+            template <unsigned FracBits>
+            static int32_t smooth(int32_t current, int32_t target, int32_t speed, int32_t epsilon)
+            {
+                const int64_t d = static_cast<int64_t>(target) - current;
+                const uint64_t nMag = static_cast<uint64_t>((d < 0) ? -d : d);
+                const uint64_t nSpeed = static_cast<uint64_t>(speed);
+                const uint64_t nStep = ((nMag << FracBits) + nSpeed / 2) / nSpeed;
+                if ((nStep == 0) || ((epsilon >= 0) && (nMag - nStep <= static_cast<uint64_t>(epsilon))))
+                {
+                    return target;
+                }
+                return static_cast<int32_t>(current + ((d < 0) ? -static_cast<int64_t>(nStep) : static_cast<int64_t>(nStep)));
+            }
+        };
+
+        template <>
+        struct FixedPointOps<int64_t>
+        {
+            static bool saturate(bool bNegative, uint64_t nMag, int64_t& result)
+            {
+                const uint64_t nLimit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + (bNegative ? 1 : 0);
+                if (nMag > nLimit)
+                {
+                    result = bNegative ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+                    return false;
+                }
+                result = static_cast<int64_t>(bNegative ? (0 - nMag) : nMag);
+                return true;
+            }
+
+            static uint64_t magnitude(int64_t a)
+            {
+                return (a < 0) ? (0 - static_cast<uint64_t>(a)) : static_cast<uint64_t>(a);
+            }
+
+            static bool add(int64_t a, int64_t b, int64_t& result)
+            {
+                result = static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+                if (((a ^ result) & (b ^ result)) < 0)
+                {
+                    result = (a < 0) ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+                    return false;
+                }
+                return true;
+            }
+
+            static bool sub(int64_t a, int64_t b, int64_t& result)
+            {
+                result = static_cast<int64_t>(static_cast<uint64_t>(a) - static_cast<uint64_t>(b));
+                if (((a ^ b) & (a ^ result)) < 0)
+                {
+                    result = (a < 0) ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+                    return false;
+                }
+                return true;
+            }
+
+            template <unsigned FracBits>
+            static bool mul(int64_t a, int64_t b, int64_t& result)
+            {
+                uint64_t hi;
+                uint64_t lo;
+                mulU64(magnitude(a), magnitude(b), hi, lo);
+                const uint64_t nHalf = static_cast<uint64_t>(1) << (FracBits - 1);
+                lo += nHalf;
+                hi += (lo < nHalf) ? 1 : 0;
+                const bool bNegative = (a < 0) != (b < 0);
+                if ((hi >> FracBits) != 0)
+                {
+                    return saturate(bNegative, std::numeric_limits<uint64_t>::max(), result);
+                }
+                return saturate(bNegative, (hi << (64 - FracBits)) | (lo >> FracBits), result);
+            }
+
+            template <unsigned FracBits>
+            static bool div(int64_t a, int64_t b, int64_t& result)
+            {
+                if (b == 0)
+                {
+                    result = (a > 0) ? std::numeric_limits<int64_t>::max() : ((a < 0) ? std::numeric_limits<int64_t>::min() : 0);
+                    return false;
+                }
+                const uint64_t nMagA = magnitude(a);
+                const uint64_t nMagB = magnitude(b);
+                uint64_t hi = nMagA >> (64 - FracBits);
+                uint64_t lo = nMagA << FracBits;
+                lo += nMagB / 2;
+                hi += (lo < nMagB / 2) ? 1 : 0;
+                const bool bNegative = (a < 0) != (b < 0);
+                if (hi >= nMagB)
+                {
+                    return saturate(bNegative, std::numeric_limits<uint64_t>::max(), result);
+                }
+                return saturate(bNegative, divU128(hi, lo, nMagB), result);
+            }
+
+            template <unsigned FracBits>
+            static int64_t sqrt(int64_t a)
+            {
+                if (a <= 0)
+                {
+                    return 0;
+                }
+                return static_cast<int64_t>(sqrtU128(static_cast<uint64_t>(a) >> (64 - FracBits), static_cast<uint64_t>(a) << FracBits));
+            }
+
+            template <unsigned FracBits>
+            static uint32_t toTurn(int64_t a)
+            {
+                uint64_t hi;
+                uint64_t lo;
+                mulU64(magnitude(a), TurnsPerRadianQ32, hi, lo);
+                const uint32_t nTurn = static_cast<uint32_t>((lo >> FracBits) | (hi << (64 - FracBits)));
+                return (a < 0) ? (0 - nTurn) : nTurn;
+            }
+
+            /** t must be in [0, 2^FracBits]. */
+            template <unsigned FracBits>
+            static int64_t lerp(int64_t a, int64_t b, int64_t t)
+            {
+                // the result is between a and b, so it is exact in wrapping unsigned arithmetic
+                const bool bNegative = b < a;
+                const uint64_t nMag = bNegative ? (static_cast<uint64_t>(a) - static_cast<uint64_t>(b)) : (static_cast<uint64_t>(b) - static_cast<uint64_t>(a));
+                uint64_t hi;
+                uint64_t lo;
+                mulU64(nMag, static_cast<uint64_t>(t), hi, lo);
+                const uint64_t nHalf = static_cast<uint64_t>(1) << (FracBits - 1);
+                lo += nHalf;
+                hi += (lo < nHalf) ? 1 : 0;
+                const uint64_t q = (hi << (64 - FracBits)) | (lo >> FracBits);
+                return static_cast<int64_t>(bNegative ? (static_cast<uint64_t>(a) - q) : (static_cast<uint64_t>(a) + q));
+            }
+
+            /** speed must be greater than 2^FracBits. */
+            template <unsigned FracBits>
+            static int64_t smooth(int64_t current, int64_t target, int64_t speed, int64_t epsilon)
+            {
+                const bool bNegative = target < current;
+                const uint64_t nMag = bNegative ?
+                    (static_cast<uint64_t>(current) - static_cast<uint64_t>(target)) :
+                    (static_cast<uint64_t>(target) - static_cast<uint64_t>(current));
+                const uint64_t nSpeed = static_cast<uint64_t>(speed);
+                // hi is less than 2^FracBits + 1, so it is less than nSpeed
+                uint64_t hi = nMag >> (64 - FracBits);
+                uint64_t lo = nMag << FracBits;
+                lo += nSpeed / 2;
+                hi += (lo < nSpeed / 2) ? 1 : 0;
+                const uint64_t nStep = divU128(hi, lo, nSpeed);
+                if ((nStep == 0) || ((epsilon >= 0) && (nMag - nStep <= static_cast<uint64_t>(epsilon))))
+                {
+                    return target;
+                }
+                return static_cast<int64_t>(bNegative ? (static_cast<uint64_t>(current) - nStep) : (static_cast<uint64_t>(current) + nStep));
+            }
+        };
+
+    } // namespace detail
+
+    /**
+    * Signed fixed-point number: a RawT integer scaled by 2^-FracBits.
+    *
+    * Unlike float math, every operation gives bit-identical results on every platform, compiler and optimization level, so a
+    * lockstep or rollback simulation stays in sync between machines by exchanging only inputs.
+    *
+    * Operators saturate instead of wrapping around on overflow, so an overflow does not flip the sign of a position or velocity.
+    * Use checkedAdd() etc. to detect overflow. Division by zero gives the max or min value by the sign of the dividend.
+    * Multiplication and division round to nearest.
+    *
+    * Values are created explicitly by fromInt(), fromRaw(), fromDouble() etc., there is no implicit conversion.
+    * Converting from float or double is deterministic for the same input value, but input values computed by float math are not
+    * necessarily the same on every machine, so such values should be converted only once, e.g. when loading a map.
+    */
+    template <typename RawT, unsigned FracBits>
+    class FixedPoint
+    {
+        static_assert((FracBits >= 1) && (FracBits < sizeof(RawT) * 8 - 1), "Invalid number of fraction bits!");
+
+        typedef detail::FixedPointOps<RawT> Ops;
+
+    public:
+
+        typedef RawT RawType;
+        static constexpr unsigned FractionBits = FracBits;
+        static constexpr RawT OneRaw = static_cast<RawT>(static_cast<RawT>(1) << FracBits);
+
+        constexpr FixedPoint() :
+            m_raw(0)
+        {}
+
+        static constexpr FixedPoint fromRaw(RawT raw)
+        {
+            return FixedPoint(raw, RawTag());
+        }
+
+        /**
+        * @return The given integer, saturated if it does not fit.
+        */
+        static FixedPoint fromInt(int64_t n)
+        {
+            if (n > static_cast<int64_t>(std::numeric_limits<RawT>::max() >> FracBits))
+            {
+                return maxValue();
+            }
+            if (n < static_cast<int64_t>(std::numeric_limits<RawT>::min() >> FracBits))
+            {
+                return minValue();
+            }
+            return fromRaw(static_cast<RawT>(n * OneRaw));
+        }
+
+        /**
+        * @return The given value rounded to the nearest representable value, saturated if it does not fit. NaN becomes zero.
+        */
+        static FixedPoint fromDouble(double d)
+        {
+            const double fScaled = d * static_cast<double>(OneRaw);
+            if (fScaled != fScaled)
+            {
+                return FixedPoint();
+            }
+            if (fScaled >= static_cast<double>(std::numeric_limits<RawT>::max()))
+            {
+                return maxValue();
+            }
+            if (fScaled <= static_cast<double>(std::numeric_limits<RawT>::min()))
+            {
+                return minValue();
+            }
+            return fromRaw(static_cast<RawT>((fScaled < 0.0) ? (fScaled - 0.5) : (fScaled + 0.5)));
+        }
+
+        static FixedPoint fromFloat(float f)
+        {
+            return fromDouble(f);
+        }
+
+        static constexpr FixedPoint zero()
+        {
+            return FixedPoint();
+        }
+
+        static constexpr FixedPoint one()
+        {
+            return fromRaw(OneRaw);
+        }
+
+        static constexpr FixedPoint half()
+        {
+            return fromRaw(OneRaw / 2);
+        }
+
+        static constexpr FixedPoint pi()
+        {
+            return fromRaw(static_cast<RawT>(3.14159265358979323846 * OneRaw + 0.5));
+        }
+
+        /**
+        * @return The smallest positive value.
+        */
+        static constexpr FixedPoint epsilon()
+        {
+            return fromRaw(1);
+        }
+
+        static constexpr FixedPoint maxValue()
+        {
+            return fromRaw(std::numeric_limits<RawT>::max());
+        }
+
+        static constexpr FixedPoint minValue()
+        {
+            return fromRaw(std::numeric_limits<RawT>::min());
+        }
+
+        constexpr RawT raw() const
+        {
+            return m_raw;
+        }
+
+        double toDouble() const
+        {
+            return static_cast<double>(m_raw) / static_cast<double>(OneRaw);
+        }
+
+        float toFloat() const
+        {
+            return static_cast<float>(toDouble());
+        }
+
+        /**
+        * @return The largest integer not greater than this value.
+        */
+        RawT toInt() const
+        {
+            return static_cast<RawT>(m_raw >> FracBits);
+        }
+
+        /**
+        * @return The nearest integer, halfway cases rounded up.
+        */
+        RawT roundToInt() const
+        {
+            RawT r;
+            Ops::add(m_raw, OneRaw / 2, r);
+            return static_cast<RawT>(r >> FracBits);
+        }
+
+        FixedPoint operator+(FixedPoint other) const
+        {
+            RawT r;
+            Ops::add(m_raw, other.m_raw, r);
+            return fromRaw(r);
+        }
+
+        FixedPoint operator-(FixedPoint other) const
+        {
+            RawT r;
+            Ops::sub(m_raw, other.m_raw, r);
+            return fromRaw(r);
+        }
+
+        FixedPoint operator*(FixedPoint other) const
+        {
+            RawT r;
+            Ops::template mul<FracBits>(m_raw, other.m_raw, r);
+            return fromRaw(r);
+        }
+
+        FixedPoint operator/(FixedPoint other) const
+        {
+            RawT r;
+            Ops::template div<FracBits>(m_raw, other.m_raw, r);
+            return fromRaw(r);
+        }
+
+        FixedPoint operator-() const
+        {
+            RawT r;
+            Ops::sub(0, m_raw, r);
+            return fromRaw(r);
+        }
+
+        FixedPoint& operator+=(FixedPoint other)
+        {
+            return *this = *this + other;
+        }
+
+        FixedPoint& operator-=(FixedPoint other)
+        {
+            return *this = *this - other;
+        }
+
+        FixedPoint& operator*=(FixedPoint other)
+        {
+            return *this = *this * other;
+        }
+
+        FixedPoint& operator/=(FixedPoint other)
+        {
+            return *this = *this / other;
+        }
+
+        constexpr bool operator==(FixedPoint other) const
+        {
+            return m_raw == other.m_raw;
+        }
+
+        constexpr bool operator!=(FixedPoint other) const
+        {
+            return m_raw != other.m_raw;
+        }
+
+        constexpr bool operator<(FixedPoint other) const
+        {
+            return m_raw < other.m_raw;
+        }
+
+        constexpr bool operator<=(FixedPoint other) const
+        {
+            return m_raw <= other.m_raw;
+        }
+
+        constexpr bool operator>(FixedPoint other) const
+        {
+            return m_raw > other.m_raw;
+        }
+
+        constexpr bool operator>=(FixedPoint other) const
+        {
+            return m_raw >= other.m_raw;
+        }
+
+    private:
+
+        struct RawTag {};
+
+        constexpr FixedPoint(RawT raw, RawTag) :
+            m_raw(raw)
+        {}
+
+        RawT m_raw;
+
+    }; // class FixedPoint
+
+    template <typename RawT, unsigned FracBits>
+    constexpr unsigned FixedPoint<RawT, FracBits>::FractionBits;
+
+    template <typename RawT, unsigned FracBits>
+    constexpr RawT FixedPoint<RawT, FracBits>::OneRaw;
+
+    typedef FixedPoint<int32_t, 16> Fix16;  /**< Q16.16: range about +-32768, resolution about 0.000015. */
+    typedef FixedPoint<int64_t, 32> Fix32;  /**< Q32.32: range about +-2 billion, resolution about 0.00000000023. */
+
+    /**
+    * Sets result to a + b, saturated.
+    * @return False if the result has overflowed.
+    */
+    template <typename RawT, unsigned FracBits>
+    bool checkedAdd(FixedPoint<RawT, FracBits> a, FixedPoint<RawT, FracBits> b, FixedPoint<RawT, FracBits>& result)
+    {
+        RawT r;
+        const bool bOk = detail::FixedPointOps<RawT>::add(a.raw(), b.raw(), r);
+        result = FixedPoint<RawT, FracBits>::fromRaw(r);
+        return bOk;
+    }
+
+    /**
+    * Sets result to a - b, saturated.
+    * @return False if the result has overflowed.
+    */
+    template <typename RawT, unsigned FracBits>
+    bool checkedSub(FixedPoint<RawT, FracBits> a, FixedPoint<RawT, FracBits> b, FixedPoint<RawT, FracBits>& result)
+    {
+        RawT r;
+        const bool bOk = detail::FixedPointOps<RawT>::sub(a.raw(), b.raw(), r);
+        result = FixedPoint<RawT, FracBits>::fromRaw(r);
+        return bOk;
+    }
+
+    /**
+    * Sets result to a * b, saturated.
+    * @return False if the result has overflowed.
+    */
+    template <typename RawT, unsigned FracBits>
+    bool checkedMul(FixedPoint<RawT, FracBits> a, FixedPoint<RawT, FracBits> b, FixedPoint<RawT, FracBits>& result)
+    {
+        RawT r;
+        const bool bOk = detail::FixedPointOps<RawT>::template mul<FracBits>(a.raw(), b.raw(), r);
+        result = FixedPoint<RawT, FracBits>::fromRaw(r);
+        return bOk;
+    }
+
+    /**
+    * Sets result to a / b, saturated.
+    * @return False if the result has overflowed or b is zero.
+    */
+    template <typename RawT, unsigned FracBits>
+    bool checkedDiv(FixedPoint<RawT, FracBits> a, FixedPoint<RawT, FracBits> b, FixedPoint<RawT, FracBits>& result)
+    {
+        RawT r;
+        const bool bOk = detail::FixedPointOps<RawT>::template div<FracBits>(a.raw(), b.raw(), r);
+        result = FixedPoint<RawT, FracBits>::fromRaw(r);
+        return bOk;
+    }
+
+    template <typename RawT, unsigned FracBits>
+    FixedPoint<RawT, FracBits> abs(FixedPoint<RawT, FracBits> value)
+    {
+        return (value.raw() < 0) ? -value : value;
+    }
+
+    /**
+    * @return The largest integer value not greater than the given value.
+    */
+    template <typename RawT, unsigned FracBits>
+    FixedPoint<RawT, FracBits> floor(FixedPoint<RawT, FracBits> value)
+    {
+        return FixedPoint<RawT, FracBits>::fromRaw(static_cast<RawT>(value.raw() & ~(FixedPoint<RawT, FracBits>::OneRaw - 1)));
+    }
+
+    /**
+    * @return The fractional part of the given value, in [0, 1) range also for negative values.
+    */
+    template <typename RawT, unsigned FracBits>
+    FixedPoint<RawT, FracBits> frac(FixedPoint<RawT, FracBits> value)
+    {
+        return FixedPoint<RawT, FracBits>::fromRaw(static_cast<RawT>(value.raw() & (FixedPoint<RawT, FracBits>::OneRaw - 1)));
+    }
+
+    /**
+    * @return Square root of the given value, rounded down. Zero for negative values.
+    */
+    template <typename RawT, unsigned FracBits>
+    FixedPoint<RawT, FracBits> sqrt(FixedPoint<RawT, FracBits> value)
+    {
+        return FixedPoint<RawT, FracBits>::fromRaw(detail::FixedPointOps<RawT>::template sqrt<FracBits>(value.raw()));
+    }
+
+    /**
+    * Fixed-point version of PFL::constrain().
+    * @return The given value constrained into the given [min,max] bounds.
+    */
+    template <typename RawT, unsigned FracBits>
+    FixedPoint<RawT, FracBits> constrain(FixedPoint<RawT, FracBits> value, FixedPoint<RawT, FracBits> min, FixedPoint<RawT, FracBits> max)
+    {
+        return (value < min) ? min : ((value > max) ? max : value);
+    }
+
+    /**
+    * Fixed-point version of PFL::lerp(): linear interpolation between v0 and v1.
+    * Unlike PFL::lerp(), v0 can be greater than v1. v1 - v0 does not need to be representable, the result is always between them.
+    *
+    * @param t Factor in range [0,1] where 0 results in v0, 1 results in v1.
+    *          Value is clamped into [0,1] range.
+    */
+    template <typename RawT, unsigned FracBits>
+    FixedPoint<RawT, FracBits> lerp(FixedPoint<RawT, FracBits> v0, FixedPoint<RawT, FracBits> v1, FixedPoint<RawT, FracBits> t)
+    {
+        t = constrain(t, FixedPoint<RawT, FracBits>::zero(), FixedPoint<RawT, FracBits>::one());
+        return FixedPoint<RawT, FracBits>::fromRaw(detail::FixedPointOps<RawT>::template lerp<FracBits>(v0.raw(), v1.raw(), t.raw()));
+    }
+
+    /**
+    * Fixed-point version of PFL::smooth(): smoothly approach target from current, by repeated calls with the returned value.
+    * Unlike the float version, the target is always reached after finite steps even with zero epsilon: when the remaining step
+    * would be rounded to zero, the target is returned.
+    *
+    * @param speed   Bigger number means slower approach. Any value less than 1 is treated as 1, which reaches target in 1 step.
+    * @param epsilon Distance between current and target where both are considered equal.
+    */
+    template <typename RawT, unsigned FracBits>
+    FixedPoint<RawT, FracBits> smooth(
+        FixedPoint<RawT, FracBits> current, FixedPoint<RawT, FracBits> target, FixedPoint<RawT, FracBits> speed,
+        FixedPoint<RawT, FracBits> epsilon = FixedPoint<RawT, FracBits>::zero())
+    {
+        if (speed <= FixedPoint<RawT, FracBits>::one())
+        {
+            return target;
+        }
+        return FixedPoint<RawT, FracBits>::fromRaw(
+            detail::FixedPointOps<RawT>::template smooth<FracBits>(current.raw(), target.raw(), speed.raw(), epsilon.raw()));
+    }
+
+    /**
+    * Deterministic sine of the given angle in radians, by linear interpolation in a 1025-entry quarter-wave lookup table.
+    * Max error is about 0.0000003, plus the resolution of the type.
+    */
+    template <typename RawT, unsigned FracBits>
+    FixedPoint<RawT, FracBits> sin(FixedPoint<RawT, FracBits> radian)
+    {
+        static_assert(FracBits <= 32, "Lookup table has no more precision!");
+        const int32_t nSin = detail::sinTurn(detail::FixedPointOps<RawT>::template toTurn<FracBits>(radian.raw()));
+        return FixedPoint<RawT, FracBits>::fromRaw(static_cast<RawT>(detail::roundShiftRight(static_cast<int64_t>(nSin) * 4, 32 - FracBits)));
+    }
+
+    /**
+    * Deterministic cosine of the given angle in radians, see sin().
+    */
+    template <typename RawT, unsigned FracBits>
+    FixedPoint<RawT, FracBits> cos(FixedPoint<RawT, FracBits> radian)
+    {
+        static_assert(FracBits <= 32, "Lookup table has no more precision!");
+        const uint32_t nQuarterTurn = 0x40000000u;
+        const int32_t nCos = detail::sinTurn(detail::FixedPointOps<RawT>::template toTurn<FracBits>(radian.raw()) + nQuarterTurn);
+        return FixedPoint<RawT, FracBits>::fromRaw(static_cast<RawT>(detail::roundShiftRight(static_cast<int64_t>(nCos) * 4, 32 - FracBits)));
+    }
+
+    /**
+    * Fixed-point version of PFL::degToRad().
+    */
+    template <typename RawT, unsigned FracBits>
+    FixedPoint<RawT, FracBits> degToRad(FixedPoint<RawT, FracBits> degree)
+    {
+        return degree * FixedPoint<RawT, FracBits>::pi() / FixedPoint<RawT, FracBits>::fromInt(180);
+    }
+
+    /**
+    * Fixed-point version of PFL::radToDeg().
+    */
+    template <typename RawT, unsigned FracBits>
+    FixedPoint<RawT, FracBits> radToDeg(FixedPoint<RawT, FracBits> radian)
+    {
+        return radian * FixedPoint<RawT, FracBits>::fromInt(180) / FixedPoint<RawT, FracBits>::pi();
+    }
+
+} // namespace
@@ -0,0 +1,323 @@
+/*
+    ###################################################################################
+    HdrHistogram.cpp
+    Fixed-memory high dynamic range histogram with lock-free recording and percentile queries.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include "HdrHistogram.h"
+
+#include <limits>
+#include <stdexcept>
+
+
+// ############################### PUBLIC ################################
+
+
+/**
+    @param nHighestTrackableValue  Highest value to be tracked.
+                                   Must be at least twice the lowest discernible value.
+                                   Exception is thrown for smaller value.
+    @param nSignificantDigits      Number of significant decimal digits kept for each value, e.g. 3 means values are recorded with
+                                   0.1% precision.
+                                   Must be in range [1, 5].
+                                   Exception is thrown for value out of range.
+    @param nLowestDiscernibleValue Lowest value that can be told apart from 0, e.g. 1000 for nanosecond values if microsecond
+                                   precision is enough, saving memory.
+                                   Must be positive.
+                                   Exception is thrown for non-positive value.
+*/
+pfl::HdrHistogram::HdrHistogram(int64_t nHighestTrackableValue, int nSignificantDigits, int64_t nLowestDiscernibleValue) :
+    m_nLowestDiscernibleValue(nLowestDiscernibleValue),
+    m_nHighestTrackableValue(nHighestTrackableValue),
+    m_nSignificantDigits(nSignificantDigits),
+    m_nOverflowCount(0)
+{
+    if (nLowestDiscernibleValue < 1)
+    {
+        throw std::runtime_error("Lowest discernible value must be positive!");
+    }
+    if ((nSignificantDigits < 1) || (nSignificantDigits > 5))
+    {
+        throw std::runtime_error("Significant digits must be in range [1, 5]!");
+    }
+    if (nHighestTrackableValue / 2 < nLowestDiscernibleValue)
+    {
+        throw std::runtime_error("Highest trackable value must be at least twice the lowest discernible value!");
+    }
+
+    // number of sub-buckets is the power of 2 giving single unit resolution up to 2 * 10^digits
+    int64_t nLargestValueWithSingleUnitResolution = 2;
+    for (int i = 0; i < nSignificantDigits; i++)
+    {
+        nLargestValueWithSingleUnitResolution *= 10;
+    }
+    int nSubBucketCountMagnitude = 0;
+    while ((int64_t(1) << nSubBucketCountMagnitude) < nLargestValueWithSingleUnitResolution)
+    {
+        nSubBucketCountMagnitude++;
+    }
+    m_nSubBucketHalfCountMagnitude = nSubBucketCountMagnitude - 1;
+
+    m_nUnitMagnitude = 0;
+    while ((nLowestDiscernibleValue >> (m_nUnitMagnitude + 1)) != 0)
+    {
+        m_nUnitMagnitude++;
+    }
+    if (m_nUnitMagnitude + m_nSubBucketHalfCountMagnitude > 61)
+    {
+        throw std::runtime_error("Lowest discernible value is too big for the requested precision!");
+    }
+
+    m_nSubBucketCount = int64_t(1) << (m_nSubBucketHalfCountMagnitude + 1);
+    m_nSubBucketHalfCount = m_nSubBucketCount / 2;
+    m_nSubBucketMask = (m_nSubBucketCount - 1) << m_nUnitMagnitude;
+    m_nLeadingZeroCountBase = 64 - m_nUnitMagnitude - m_nSubBucketHalfCountMagnitude - 1;
+
+    // each bucket doubles the range of the previous one
+    int64_t nSmallestUntrackableValue = m_nSubBucketCount << m_nUnitMagnitude;
+    size_t nBuckets = 1;
+    while (nSmallestUntrackableValue <= nHighestTrackableValue)
+    {
+        if (nSmallestUntrackableValue > (std::numeric_limits<int64_t>::max)() / 2)
+        {
+            nBuckets++;
+            break;
+        }
+        nSmallestUntrackableValue <<= 1;
+        nBuckets++;
+    }
+
+    // the lower half of sub-buckets of all buckets but the first overlaps the previous bucket, so they are not stored
+    m_nCounts = (nBuckets + 1) * static_cast<size_t>(m_nSubBucketHalfCount);
+    m_counts.reset(new std::atomic<uint64_t>[m_nCounts]);
+    reset();
+} // HdrHistogram()
+
+
+/**
+    Records the duration between 2 timestamps in microseconds. Thread-safe, lock-free.
+    Unlike PFL::getTimeDiffInUs(), the difference is calculated in 64 bits, so it does not overflow for long durations.
+
+    @return True if recorded, false if the duration is negative or too long to be tracked.
+*/
+bool pfl::HdrHistogram::recordDuration(const PFL::timeval& timeBegin, const PFL::timeval& timeEnd)
+{
+    return record(static_cast<int64_t>(timeEnd.tv_sec - timeBegin.tv_sec) * 1000000 + (timeEnd.tv_usec - timeBegin.tv_usec));
+} // recordDuration()
+
+
+/**
+    Adds all counts of the other histogram to this histogram, e.g. to merge per-thread histograms.
+    Histograms with different configuration can be added too, values are then re-recorded with the precision of this histogram.
+    Thread-safe with respect to concurrent recording into any of the histograms.
+
+    @return Number of values of the other histogram which are out of the trackable range of this histogram.
+            These, together with the overflow count of the other histogram, are added to getOverflowCount().
+*/
+uint64_t pfl::HdrHistogram::add(const HdrHistogram& other)
+{
+    uint64_t nDropped = 0;
+    for (size_t i = 0; i < other.m_nCounts; i++)
+    {
+        const uint64_t nCount = other.m_counts[i].load(std::memory_order_relaxed);
+        if ((nCount != 0) && !record(other.valueFromIndex(i), nCount))
+        {
+            nDropped += nCount;
+        }
+    }
+    m_nOverflowCount.fetch_add(other.getOverflowCount(), std::memory_order_relaxed);
+    return nDropped;
+} // add()
+
+
+/**
+    Clears all counts, including the overflow count.
+    Values recorded concurrently might or might not be kept.
+*/
+void pfl::HdrHistogram::reset()
+{
+    for (size_t i = 0; i < m_nCounts; i++)
+    {
+        m_counts[i].store(0, std::memory_order_relaxed);
+    }
+    m_nOverflowCount.store(0, std::memory_order_relaxed);
+} // reset()
+
+
+/**
+    @return Number of recorded values, not including the overflow count.
+*/
+uint64_t pfl::HdrHistogram::getTotalCount() const
+{
+    uint64_t nTotal = 0;
+    for (size_t i = 0; i < m_nCounts; i++)
+    {
+        nTotal += m_counts[i].load(std::memory_order_relaxed);
+    }
+    return nTotal;
+} // getTotalCount()
+
+
+/**
+    @return The lowest recorded value, rounded down to the lowest equivalent value of its bucket, 0 if nothing has been recorded.
+*/
+int64_t pfl::HdrHistogram::getMin() const
+{
+    for (size_t i = 0; i < m_nCounts; i++)
+    {
+        if (m_counts[i].load(std::memory_order_relaxed) != 0)
+        {
+            return valueFromIndex(i);
+        }
+    }
+    return 0;
+} // getMin()
+
+
+/**
+    @return The highest recorded value, rounded up to the highest equivalent value of its bucket, 0 if nothing has been recorded.
+*/
+int64_t pfl::HdrHistogram::getMax() const
+{
+    for (size_t i = m_nCounts; i > 0; i--)
+    {
+        if (m_counts[i - 1].load(std::memory_order_relaxed) != 0)
+        {
+            return highestEquivalentValueFromIndex(i - 1);
+        }
+    }
+    return 0;
+} // getMax()
+
+
+/**
+    @return Mean of the recorded values, taking each value as the middle of its bucket, 0 if nothing has been recorded.
+*/
+double pfl::HdrHistogram::getMean() const
+{
+    uint64_t nTotal = 0;
+    double fSum = 0.0;
+    for (size_t i = 0; i < m_nCounts; i++)
+    {
+        const uint64_t nCount = m_counts[i].load(std::memory_order_relaxed);
+        if (nCount != 0)
+        {
+            const int64_t nValue = valueFromIndex(i);
+            const int64_t nMedian = nValue + sizeOfEquivalentRange(nValue) / 2;
+            fSum += static_cast<double>(nMedian) * static_cast<double>(nCount);
+            nTotal += nCount;
+        }
+    }
+    return (nTotal == 0) ? 0.0 : (fSum / static_cast<double>(nTotal));
+} // getMean()
+
+
+/**
+    Gets the value below or at which the given percentage of recorded values are, e.g. 99.9 for p99.9.
+
+    @param fPercentile Percentile in range [0, 100]. Value out of range is clamped.
+
+    @return The highest equivalent value of the bucket of the value at the given percentile, or getMin() for 0 percentile.
+            0 if nothing has been recorded.
+*/
+int64_t pfl::HdrHistogram::getValueAtPercentile(double fPercentile) const
+{
+    if (!(fPercentile > 0.0))
+    {
+        return getMin();
+    }
+    if (fPercentile > 100.0)
+    {
+        fPercentile = 100.0;
+    }
+
+    const uint64_t nTotal = getTotalCount();
+    uint64_t nCountAtPercentile = static_cast<uint64_t>(fPercentile / 100.0 * static_cast<double>(nTotal) + 0.5);
+    if (nCountAtPercentile == 0)
+    {
+        nCountAtPercentile = 1;
+    }
+
+    uint64_t nCumulative = 0;
+    size_t iLastNonZero = m_nCounts;
+    for (size_t i = 0; i < m_nCounts; i++)
+    {
+        const uint64_t nCount = m_counts[i].load(std::memory_order_relaxed);
+        if (nCount != 0)
+        {
+            iLastNonZero = i;
+            nCumulative += nCount;
+            if (nCumulative >= nCountAtPercentile)
+            {
+                return highestEquivalentValueFromIndex(i);
+            }
+        }
+    }
+
+    // counts might have been reset concurrently since calculating the total count
+    return (iLastNonZero == m_nCounts) ? 0 : highestEquivalentValueFromIndex(iLastNonZero);
+} // getValueAtPercentile()
+
+
+/**
+    @return The lowest value counted in the same bucket as the given non-negative value.
+*/
+int64_t pfl::HdrHistogram::lowestEquivalentValue(int64_t nValue) const
+{
+    const int iBucket = bucketIndexFor(nValue);
+    const int64_t iSubBucket = nValue >> (iBucket + m_nUnitMagnitude);
+    return iSubBucket << (iBucket + m_nUnitMagnitude);
+} // lowestEquivalentValue()
+
+
+/**
+    @return The highest value counted in the same bucket as the given non-negative value.
+*/
+int64_t pfl::HdrHistogram::highestEquivalentValue(int64_t nValue) const
+{
+    return lowestEquivalentValue(nValue) + sizeOfEquivalentRange(nValue) - 1;
+} // highestEquivalentValue()
+
+
+// ############################## PROTECTED ##############################
+
+
+// ############################### PRIVATE ###############################
+
+
+/**
+    @return The lowest value counted by the counter at the given index.
+*/
+int64_t pfl::HdrHistogram::valueFromIndex(size_t index) const
+{
+    int iBucket = static_cast<int>(index >> m_nSubBucketHalfCountMagnitude) - 1;
+    int64_t iSubBucket = static_cast<int64_t>(index & static_cast<size_t>(m_nSubBucketHalfCount - 1)) + m_nSubBucketHalfCount;
+    if (iBucket < 0)
+    {
+        iSubBucket -= m_nSubBucketHalfCount;
+        iBucket = 0;
+    }
+    return iSubBucket << (iBucket + m_nUnitMagnitude);
+} // valueFromIndex()
+
+
+/**
+    @return Number of distinct values counted in the same bucket as the given non-negative value.
+*/
+int64_t pfl::HdrHistogram::sizeOfEquivalentRange(int64_t nValue) const
+{
+    const int iBucket = bucketIndexFor(nValue);
+    const int64_t iSubBucket = nValue >> (iBucket + m_nUnitMagnitude);
+    const int iAdjustedBucket = (iSubBucket >= m_nSubBucketCount) ? (iBucket + 1) : iBucket;
+    return int64_t(1) << (m_nUnitMagnitude + iAdjustedBucket);
+} // sizeOfEquivalentRange()
+
+
+int64_t pfl::HdrHistogram::highestEquivalentValueFromIndex(size_t index) const
+{
+    return highestEquivalentValue(valueFromIndex(index));
+} // highestEquivalentValueFromIndex()
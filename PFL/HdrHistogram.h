@@ -0,0 +1,182 @@
+#pragma once
+
+/*
+    ###################################################################################
+    HdrHistogram.h
+    Fixed-memory high dynamic range histogram with lock-free recording and percentile queries.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "PFL.h"
+
+namespace pfl
+{
+    /**
+    * High dynamic range histogram, following the log-linear bucketing of Gil Tene's HdrHistogram.
+    *
+    * Values in range [lowest discernible value, highest trackable value] are recorded with the given number of significant
+    * decimal digits of precision: the value space is divided into buckets of power of 2 ranges, each split into the same number of
+    * linear sub-buckets. Memory is allocated once in constructor, e.g. ~190 KB for 1 us .. 1 hour with 3 significant digits.
+    *
+    * Recording is a single relaxed atomic increment, so any number of threads can record concurrently without locking.
+    * Total count, min, max and mean are not maintained by recording, they are calculated by the queries from the counts, so queries
+    * are linear in the number of counters. Queries running concurrently with recording see a consistent-enough snapshot for
+    * statistics, but not necessarily including the most recent samples.
+    *
+    * The unit of values is up to the user, e.g. microseconds from PFL::getTimeDiffInUs() or nanoseconds from a steady clock.
+    */
+    class HdrHistogram
+    {
+
+    public:
+
+        HdrHistogram(int64_t nHighestTrackableValue, int nSignificantDigits = 3, int64_t nLowestDiscernibleValue = 1);
+        ~HdrHistogram() = default;
+
+        HdrHistogram(const HdrHistogram&) = delete;
+        HdrHistogram& operator=(const HdrHistogram&) = delete;
+        HdrHistogram(HdrHistogram&&) = delete;
+        HdrHistogram& operator=(HdrHistogram&&) = delete;
+
+        /**
+        * Records a value. Thread-safe, lock-free.
+        * @param nValue Value to be recorded.
+        * @return True if recorded, false if the value is negative or too big to be tracked. Such values are counted by getOverflowCount().
+        */
+        bool record(int64_t nValue)
+        {
+            return record(nValue, 1);
+        }
+
+        /**
+        * Records a value the given number of times. Thread-safe, lock-free.
+        * @param nValue Value to be recorded.
+        * @param nCount Number of occurrences of the value.
+        * @return True if recorded, false if the value is negative or too big to be tracked. Such values are counted by getOverflowCount().
+        *         Values a bit above the highest trackable value might still be recorded, up to the end of the last bucket.
+        */
+        bool record(int64_t nValue, uint64_t nCount)
+        {
+            const size_t index = (nValue < 0) ? m_nCounts : countsIndexFor(nValue);
+            if (index >= m_nCounts)
+            {
+                m_nOverflowCount.fetch_add(nCount, std::memory_order_relaxed);
+                return false;
+            }
+            m_counts[index].fetch_add(nCount, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool recordDuration(const PFL::timeval& timeBegin, const PFL::timeval& timeEnd);  /**< Records the duration between 2 timestamps in microseconds. */
+        uint64_t add(const HdrHistogram& other);                                          /**< Adds all counts of the other histogram to this histogram. */
+        void reset();                                                                     /**< Clears all counts. */
+
+        uint64_t getTotalCount() const;                          /**< Gets the number of recorded values. */
+        int64_t getMin() const;                                  /**< Gets the lowest recorded value, rounded down to its bucket. */
+        int64_t getMax() const;                                  /**< Gets the highest recorded value, rounded up to its bucket. */
+        double getMean() const;                                  /**< Gets the mean of recorded values, based on the bucket midpoints. */
+        int64_t getValueAtPercentile(double fPercentile) const;  /**< Gets the value below or at which the given percentage of values are. */
+
+        int64_t lowestEquivalentValue(int64_t nValue) const;     /**< Gets the lowest value counted in the same bucket as the given value. */
+        int64_t highestEquivalentValue(int64_t nValue) const;    /**< Gets the highest value counted in the same bucket as the given value. */
+
+        /**
+        * @return Number of values not recorded because being out of the trackable range.
+        */
+        uint64_t getOverflowCount() const
+        {
+            return m_nOverflowCount.load(std::memory_order_relaxed);
+        }
+
+        int64_t getLowestDiscernibleValue() const
+        {
+            return m_nLowestDiscernibleValue;
+        }
+
+        int64_t getHighestTrackableValue() const
+        {
+            return m_nHighestTrackableValue;
+        }
+
+        int getSignificantDigits() const
+        {
+            return m_nSignificantDigits;
+        }
+
+        /**
+        * @return Number of counters, each taking 8 bytes.
+        */
+        size_t getCountsLength() const
+        {
+            return m_nCounts;
+        }
+
+    private:
+        int64_t m_nLowestDiscernibleValue;
+        int64_t m_nHighestTrackableValue;
+        int m_nSignificantDigits;
+        int m_nUnitMagnitude;                  /**< log2 of the lowest discernible value, rounded down. */
+        int m_nSubBucketHalfCountMagnitude;
+        int64_t m_nSubBucketCount;             /**< Number of linear sub-buckets per bucket, a power of 2. */
+        int64_t m_nSubBucketHalfCount;
+        int64_t m_nSubBucketMask;
+        int m_nLeadingZeroCountBase;
+        size_t m_nCounts;
+        std::unique_ptr<std::atomic<uint64_t>[]> m_counts;
+        std::atomic<uint64_t> m_nOverflowCount;
+
+        /**
+        * @return Number of leading zero bits of the given non-zero value.
+        */
+        static int countLeadingZeros(uint64_t nValue)
+        {
+#ifdef _MSC_VER
+            unsigned long iBit;
+#if defined(_M_X64) || defined(_M_ARM64)
+            _BitScanReverse64(&iBit, nValue);
+            return 63 - static_cast<int>(iBit);
+#else
+            if (_BitScanReverse(&iBit, static_cast<unsigned long>(nValue >> 32)))
+            {
+                return 31 - static_cast<int>(iBit);
+            }
+            _BitScanReverse(&iBit, static_cast<unsigned long>(nValue));
+            return 63 - static_cast<int>(iBit);
+#endif
+#else
+            return __builtin_clzll(nValue);
+#endif
+        }
+
+        int bucketIndexFor(int64_t nValue) const
+        {
+            // the mask makes sure values in the first bucket get bucket index 0, and the argument is never 0
+            return m_nLeadingZeroCountBase - countLeadingZeros(static_cast<uint64_t>(nValue | m_nSubBucketMask));
+        }
+
+        size_t countsIndexFor(int64_t nValue) const
+        {
+            const int iBucket = bucketIndexFor(nValue);
+            const int64_t iSubBucket = nValue >> (iBucket + m_nUnitMagnitude);
+            return static_cast<size_t>((static_cast<int64_t>(iBucket + 1) << m_nSubBucketHalfCountMagnitude) + (iSubBucket - m_nSubBucketHalfCount));
+        }
+
+        int64_t valueFromIndex(size_t index) const;
+        int64_t sizeOfEquivalentRange(int64_t nValue) const;
+        int64_t highestEquivalentValueFromIndex(size_t index) const;
+
+    }; // class HdrHistogram
+
+} // namespace
@@ -0,0 +1,543 @@
+#pragma once
+
+/*
+    ###################################################################################
+    IntrusivePtr.h
+    Intrusive reference-counted smart pointer, with the reference count embedded in the pointed object.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace pfl
+{
+    /**
+    * Reference counting policy of RefCounted for objects shared by a single thread only: plain integer operations.
+    */
+    struct RefCountPolicySingleThread
+    {
+        typedef uint32_t CounterType;
+
+        static void increment(CounterType& n)
+        {
+            ++n;
+        }
+
+        /** @return True if the count has reached zero. */
+        static bool decrement(CounterType& n)
+        {
+            assert(n > 0);
+            return --n == 0;
+        }
+
+        static uint32_t load(const CounterType& n)
+        {
+            return n;
+        }
+    };
+
+    /**
+    * Reference counting policy of RefCounted for objects shared by multiple threads: atomic operations, like std::shared_ptr.
+    */
+    struct RefCountPolicyAtomic
+    {
+        typedef std::atomic<uint32_t> CounterType;
+
+        static void increment(CounterType& n)
+        {
+            // a new reference can only be made from an existing one, so no ordering is needed
+            n.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /** @return True if the count has reached zero. */
+        static bool decrement(CounterType& n)
+        {
+            if (n.fetch_sub(1, std::memory_order_release) == 1)
+            {
+                // all writes to the object by other owners happen before its deletion
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return true;
+            }
+            return false;
+        }
+
+        static uint32_t load(const CounterType& n)
+        {
+            return n.load(std::memory_order_relaxed);
+        }
+    };
+
+    /**
+    * Base class embedding the reference count into objects managed by intrusive_ptr, so object and count live in a single allocation.
+    * Uses CRTP: derive class X from RefCounted<X>, so no virtual destructor is needed. If X has derived classes deleted through
+    * intrusive_ptr<X>, X needs a virtual destructor as usual.
+    * Objects must be allocated with new (or make_intrusive()), as they are deleted with delete when the count reaches zero.
+    *
+    * Copying a RefCounted object does not copy the count: a copy starts with no references.
+    */
+    template <typename Derived, typename Policy = RefCountPolicyAtomic>
+    class RefCounted
+    {
+
+    public:
+
+        typedef Policy RefCountPolicy;
+
+        /**
+        * @return Number of intrusive_ptr instances referring to this object. With the atomic policy the value might be outdated by the time it is used.
+        */
+        uint32_t use_count() const
+        {
+            return Policy::load(m_nRefs);
+        }
+
+        friend void intrusive_ptr_add_ref(const RefCounted* p)
+        {
+            Policy::increment(p->m_nRefs);
+        }
+
+        friend void intrusive_ptr_release(const RefCounted* p)
+        {
+            if (Policy::decrement(p->m_nRefs))
+            {
+                delete static_cast<const Derived*>(p);
+            }
+        }
+
+    protected:
+
+        RefCounted() = default;
+        ~RefCounted() = default;
+
+        RefCounted(const RefCounted&) :
+            m_nRefs(0)
+        {
+        }
+
+        RefCounted& operator=(const RefCounted&)
+        {
+            return *this;
+        }
+
+    private:
+        mutable typename Policy::CounterType m_nRefs{ 0 };
+
+    }; // class RefCounted
+
+    /**
+    * Smart pointer to an object with embedded reference count, e.g. derived from RefCounted.
+    * Works with any type for which intrusive_ptr_add_ref(T*) and intrusive_ptr_release(T*) are found by argument-dependent lookup,
+    * same protocol as boost::intrusive_ptr.
+    * Same size as a raw pointer, and copying it costs a single increment of a count located in the pointed object.
+    */
+    template <typename T>
+    class intrusive_ptr
+    {
+
+    public:
+
+        typedef T element_type;
+
+        intrusive_ptr() noexcept = default;
+
+        intrusive_ptr(std::nullptr_t) noexcept
+        {
+        }
+
+        /**
+        * @param p       Object to be referred.
+        * @param bAddRef If false, an existing reference is adopted, e.g. one detached by detach() earlier.
+        */
+        explicit intrusive_ptr(T* p, bool bAddRef = true) :
+            m_p(p)
+        {
+            if (m_p && bAddRef)
+            {
+                intrusive_ptr_add_ref(m_p);
+            }
+        }
+
+        ~intrusive_ptr()
+        {
+            if (m_p)
+            {
+                intrusive_ptr_release(m_p);
+            }
+        }
+
+        intrusive_ptr(const intrusive_ptr& other) :
+            intrusive_ptr(other.m_p)
+        {
+        }
+
+        template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        intrusive_ptr(const intrusive_ptr<U>& other) :
+            intrusive_ptr(other.get())
+        {
+        }
+
+        intrusive_ptr(intrusive_ptr&& other) noexcept :
+            m_p(other.m_p)
+        {
+            other.m_p = nullptr;
+        }
+
+        template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        intrusive_ptr(intrusive_ptr<U>&& other) noexcept :
+            m_p(other.detach())
+        {
+        }
+
+        intrusive_ptr& operator=(const intrusive_ptr& other)
+        {
+            intrusive_ptr(other).swap(*this);
+            return *this;
+        }
+
+        intrusive_ptr& operator=(intrusive_ptr&& other) noexcept
+        {
+            intrusive_ptr(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        template <typename U>
+        intrusive_ptr& operator=(const intrusive_ptr<U>& other)
+        {
+            intrusive_ptr(other).swap(*this);
+            return *this;
+        }
+
+        template <typename U>
+        intrusive_ptr& operator=(intrusive_ptr<U>&& other) noexcept
+        {
+            intrusive_ptr(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        void reset() noexcept
+        {
+            intrusive_ptr().swap(*this);
+        }
+
+        void reset(T* p, bool bAddRef = true)
+        {
+            intrusive_ptr(p, bAddRef).swap(*this);
+        }
+
+        /**
+        * Gives up ownership without decrementing the count. The returned reference must be adopted later, e.g. by intrusive_ptr(p, false).
+        */
+        T* detach() noexcept
+        {
+            T* const p = m_p;
+            m_p = nullptr;
+            return p;
+        }
+
+        T* get() const noexcept
+        {
+            return m_p;
+        }
+
+        T& operator*() const
+        {
+            assert(m_p);
+            return *m_p;
+        }
+
+        T* operator->() const
+        {
+            assert(m_p);
+            return m_p;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return m_p != nullptr;
+        }
+
+        void swap(intrusive_ptr& other) noexcept
+        {
+            std::swap(m_p, other.m_p);
+        }
+
+    private:
+        T* m_p = nullptr;
+
+    }; // class intrusive_ptr
+
+    template <typename T, typename U>
+    bool operator==(const intrusive_ptr<T>& a, const intrusive_ptr<U>& b) noexcept
+    {
+        return a.get() == b.get();
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const intrusive_ptr<T>& a, const intrusive_ptr<U>& b) noexcept
+    {
+        return a.get() != b.get();
+    }
+
+    template <typename T>
+    bool operator==(const intrusive_ptr<T>& a, std::nullptr_t) noexcept
+    {
+        return !a;
+    }
+
+    template <typename T>
+    bool operator!=(const intrusive_ptr<T>& a, std::nullptr_t) noexcept
+    {
+        return static_cast<bool>(a);
+    }
+
+    template <typename T>
+    bool operator<(const intrusive_ptr<T>& a, const intrusive_ptr<T>& b) noexcept
+    {
+        return std::less<T*>()(a.get(), b.get());
+    }
+
+    template <typename T>
+    void swap(intrusive_ptr<T>& a, intrusive_ptr<T>& b) noexcept
+    {
+        a.swap(b);
+    }
+
+    /**
+    * Creates an object managed by intrusive_ptr. Unlike std::make_shared, there is nothing else to allocate beside the object.
+    */
+    template <typename T, typename... Args>
+    intrusive_ptr<T> make_intrusive(Args&&... args)
+    {
+        return intrusive_ptr<T>(new T(std::forward<Args>(args)...));
+    }
+
+    template <typename T, typename U>
+    intrusive_ptr<T> static_pointer_cast(const intrusive_ptr<U>& r)
+    {
+        return intrusive_ptr<T>(static_cast<T*>(r.get()));
+    }
+
+    template <typename T, typename U>
+    intrusive_ptr<T> dynamic_pointer_cast(const intrusive_ptr<U>& r)
+    {
+        return intrusive_ptr<T>(dynamic_cast<T*>(r.get()));
+    }
+
+    template <typename T, typename U>
+    intrusive_ptr<T> const_pointer_cast(const intrusive_ptr<U>& r)
+    {
+        return intrusive_ptr<T>(const_cast<T*>(r.get()));
+    }
+
+    /**
+    * Creates a std::shared_ptr holding a reference of the given intrusive object, for passing it to code expecting shared_ptr.
+    * The object stays alive while either kind of pointer refers to it.
+    * Note that this allocates a shared_ptr control block, so it is not for hot paths.
+    */
+    template <typename T>
+    std::shared_ptr<T> to_shared_ptr(const intrusive_ptr<T>& r)
+    {
+        if (!r)
+        {
+            return std::shared_ptr<T>();
+        }
+
+        T* const p = r.get();
+        intrusive_ptr_add_ref(p);
+        // if allocating the control block throws, the deleter is invoked, so the reference is not leaked
+        return std::shared_ptr<T>(p, [](T* pObject) { intrusive_ptr_release(pObject); });
+    }
+
+    namespace detail
+    {
+        /**
+        * Shared by an object derived from WeakRefCounted and the intrusive_weak_ptr instances referring to it.
+        */
+        struct WeakControl
+        {
+            uint32_t nRefs;  /**< References by the object and intrusive_weak_ptr instances. */
+            bool bAlive;     /**< Cleared when the object is destroyed. */
+        };
+
+        inline void releaseWeakControl(WeakControl* pControl)
+        {
+            if (--pControl->nRefs == 0)
+            {
+                delete pControl;
+            }
+        }
+    } // namespace detail
+
+    /**
+    * Base class for single-threaded intrusive objects which can be referred by intrusive_weak_ptr as well.
+    * The weak control block is allocated only when the first intrusive_weak_ptr is made, so objects never referred weakly pay
+    * only for a pointer.
+    * Weak references are supported only with the single-thread policy, as locking a weak reference from multiple threads would need
+    * a compare-and-swap loop on the count, which is exactly what makes std::weak_ptr slow.
+    */
+    template <typename Derived>
+    class WeakRefCounted : public RefCounted<Derived, RefCountPolicySingleThread>
+    {
+
+    public:
+
+        /**
+        * @return The weak control block of this object, allocated on first call.
+        */
+        detail::WeakControl* weakControl() const
+        {
+            if (!m_pWeakControl)
+            {
+                m_pWeakControl = new detail::WeakControl{ 1, true };
+            }
+            return m_pWeakControl;
+        }
+
+    protected:
+
+        WeakRefCounted() = default;
+
+        ~WeakRefCounted()
+        {
+            if (m_pWeakControl)
+            {
+                m_pWeakControl->bAlive = false;
+                detail::releaseWeakControl(m_pWeakControl);
+            }
+        }
+
+        WeakRefCounted(const WeakRefCounted& other) :
+            RefCounted<Derived, RefCountPolicySingleThread>(other)
+        {
+        }
+
+        WeakRefCounted& operator=(const WeakRefCounted&)
+        {
+            return *this;
+        }
+
+    private:
+        mutable detail::WeakControl* m_pWeakControl = nullptr;
+
+    }; // class WeakRefCounted
+
+    /**
+    * Non-owning reference to an object derived from WeakRefCounted, which can be checked for expiry and locked to an intrusive_ptr.
+    * Not thread-safe, like the single-thread policy its target uses.
+    */
+    template <typename T>
+    class intrusive_weak_ptr
+    {
+        template <typename U> friend class intrusive_weak_ptr;
+
+    public:
+
+        intrusive_weak_ptr() noexcept = default;
+
+        template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        intrusive_weak_ptr(const intrusive_ptr<U>& r)
+        {
+            static_assert(std::is_same<typename U::RefCountPolicy, RefCountPolicySingleThread>::value,
+                "Weak references are supported only for single-thread reference counting!");
+            if (r)
+            {
+                m_p = r.get();
+                m_pControl = r->weakControl();
+                m_pControl->nRefs++;
+            }
+        }
+
+        ~intrusive_weak_ptr()
+        {
+            if (m_pControl)
+            {
+                detail::releaseWeakControl(m_pControl);
+            }
+        }
+
+        intrusive_weak_ptr(const intrusive_weak_ptr& other) noexcept :
+            m_p(other.m_p),
+            m_pControl(other.m_pControl)
+        {
+            if (m_pControl)
+            {
+                m_pControl->nRefs++;
+            }
+        }
+
+        template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        intrusive_weak_ptr(const intrusive_weak_ptr<U>& other) noexcept :
+            m_pControl(other.m_pControl)
+        {
+            if (m_pControl)
+            {
+                // converting the pointer is safe only while the object is alive
+                m_p = m_pControl->bAlive ? other.m_p : nullptr;
+                m_pControl->nRefs++;
+            }
+        }
+
+        intrusive_weak_ptr(intrusive_weak_ptr&& other) noexcept :
+            m_p(other.m_p),
+            m_pControl(other.m_pControl)
+        {
+            other.m_p = nullptr;
+            other.m_pControl = nullptr;
+        }
+
+        intrusive_weak_ptr& operator=(const intrusive_weak_ptr& other) noexcept
+        {
+            intrusive_weak_ptr(other).swap(*this);
+            return *this;
+        }
+
+        intrusive_weak_ptr& operator=(intrusive_weak_ptr&& other) noexcept
+        {
+            intrusive_weak_ptr(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        void reset() noexcept
+        {
+            intrusive_weak_ptr().swap(*this);
+        }
+
+        /**
+        * @return True if the referred object has been destroyed or is being destroyed, or this is empty.
+        */
+        bool expired() const noexcept
+        {
+            return !m_pControl || !m_pControl->bAlive || (m_p->use_count() == 0);
+        }
+
+        /**
+        * @return Owning pointer to the referred object, or null pointer if expired.
+        */
+        intrusive_ptr<T> lock() const
+        {
+            return expired() ? intrusive_ptr<T>() : intrusive_ptr<T>(m_p);
+        }
+
+        void swap(intrusive_weak_ptr& other) noexcept
+        {
+            std::swap(m_p, other.m_p);
+            std::swap(m_pControl, other.m_pControl);
+        }
+
+    private:
+        T* m_p = nullptr;                             /**< Valid to dereference only while m_pControl->bAlive. */
+        detail::WeakControl* m_pControl = nullptr;
+
+    }; // class intrusive_weak_ptr
+
+} // namespace
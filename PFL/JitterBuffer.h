@@ -0,0 +1,379 @@
+#pragma once
+
+/*
+    ###################################################################################
+    JitterBuffer.h
+    Snapshot interpolation buffer of timestamped remote states, with delay adapting to network jitter.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include "FixFIFO.h"
+
+namespace pfl
+{
+    /**
+    * Default interpolator of JitterBuffer: a + (b - a) * t, for any State having these operators, e.g. float or a vector type.
+    * Unlike PFL::lerp(), a can be greater than b, and t is not clamped, so it can also extrapolate.
+    */
+    struct LinearInterpolator
+    {
+        template <typename State>
+        State operator()(const State& a, const State& b, float t) const
+        {
+            return a + (b - a) * t;
+        }
+    };
+
+    /**
+    * Result of sampling a JitterBuffer.
+    */
+    enum class JitterSample
+    {
+        None,          /**< Buffer is empty, output is untouched. */
+        Interpolated,  /**< Render time is between 2 buffered states, or at one of them. */
+        Extrapolated,  /**< Render time is after the newest state, output is predicted from the 2 newest states. */
+        Clamped        /**< Render time is outside the buffered states and cannot be extrapolated, output is the oldest or newest state. */
+    };
+
+    /**
+    * Jitter buffer for snapshot interpolation: stores remote states keyed by server tick in a FixFIFO, and gives the state at a
+    * render time slightly behind the newest received state, interpolated between the 2 states bracketing it.
+    *
+    * The render time is the estimated current server time minus a delay. The delay adapts to network jitter: the arrival time of each
+    * state is compared to its tick, and the smoothed variation of this transit time (like RTP's interarrival jitter) is added to the
+    * base delay, so render time stays behind the newest state even when packets arrive in bursts. Render time never goes backwards.
+    *
+    * The bracketing pair is found by binary search over the ring, so sampling is O(log N). For many remote entities sharing the same
+    * snapshot stream, compute renderTick() once and use sampleAt() or sampleBatch() for all entities.
+    *
+    * Interpolator is invoked as interpolator(const State& a, const State& b, float t), t being 0 at a and 1 at b, and greater than 1
+    * when extrapolating. It can interpolate the whole State struct at once, e.g. lerp position and slerp rotation.
+    *
+    * Not thread-safe.
+    */
+    template <typename State, typename Interpolator = LinearInterpolator>
+    class JitterBuffer
+    {
+
+    public:
+
+        /**
+        * @param capacity            Maximum number of states to be stored. When full, the oldest state is dropped.
+        *                            Must be positive.
+        *                            Exception is thrown for zero value.
+        * @param nTickUs             Duration of a server tick in microseconds.
+        *                            Must be positive.
+        *                            Exception is thrown for zero or negative value.
+        * @param nBaseDelayUs        Delay of render time behind the estimated server time without any jitter, usually 2 snapshot
+        *                            intervals, so that a newer state is already received when render time reaches the current one.
+        * @param nMaxExtrapolationUs How far render time can go beyond the newest state with extrapolation, before output is held
+        *                            at the extrapolated state. Zero disables extrapolation.
+        */
+        JitterBuffer(
+            const size_t& capacity,
+            int64_t nTickUs,
+            int64_t nBaseDelayUs,
+            int64_t nMaxExtrapolationUs = 0,
+            const Interpolator& interpolator = Interpolator()) :
+            m_states(capacity),
+            m_interpolator(interpolator),
+            m_fTickUs(static_cast<double>(nTickUs)),
+            m_fBaseDelayUs(static_cast<double>(nBaseDelayUs)),
+            m_fMaxExtrapolationUs(static_cast<double>(nMaxExtrapolationUs))
+        {
+            if (nTickUs <= 0)
+            {
+                throw std::runtime_error("Tick duration must be positive!");
+            }
+        }
+
+        ~JitterBuffer() = default;
+
+        JitterBuffer(const JitterBuffer&) = default;
+        JitterBuffer& operator=(const JitterBuffer&) = default;
+        JitterBuffer(JitterBuffer&&) = default;
+        JitterBuffer& operator=(JitterBuffer&&) = default;
+
+        /**
+        * Stores a received state, and updates the jitter estimate with its arrival time.
+        * Complexity: O(1) constant.
+        *
+        * @param nTick      Server tick of the state.
+        * @param state      The state.
+        * @param nArrivalUs Local time of receiving the state, in microseconds, on the same clock as given to renderTick().
+        *
+        * @return True if the state has been stored, false if it is not newer than the newest stored state, e.g. a reordered packet.
+        *         Late states still update the jitter estimate.
+        */
+        bool push(uint64_t nTick, const State& state, int64_t nArrivalUs)
+        {
+            updateTiming(nTick, nArrivalUs);
+
+            if (!m_states.empty() && (nTick <= m_states.at(m_states.size() - 1).nTick))
+            {
+                return false;
+            }
+
+            Entry entry;
+            entry.nTick = nTick;
+            entry.state = state;
+            m_states.push_back_forced(entry);
+            return true;
+        }
+
+        /**
+        * Removes all states and resets the timing estimates, e.g. on reconnect or level change.
+        */
+        void clear()
+        {
+            m_states.clear();
+            m_bHasTiming = false;
+            m_fTransitUs = 0.0;
+            m_fLastTransitUs = 0.0;
+            m_fJitterUs = 0.0;
+            m_fLastRenderTick = 0.0;
+        }
+
+        /**
+        * Calculates the render time for the given local time: the estimated server time minus the adaptive delay.
+        * The result never decreases between calls, when the delay grows render time is held until it catches up.
+        *
+        * @param nNowUs Current local time in microseconds, on the same clock as given to push().
+        *
+        * @return Render time in fractional server ticks. Zero if no state has been pushed yet.
+        */
+        double renderTick(int64_t nNowUs)
+        {
+            if (!m_bHasTiming)
+            {
+                return m_fLastRenderTick;
+            }
+
+            const double fRenderTick = (static_cast<double>(nNowUs) - m_fTransitUs - delayUs()) / m_fTickUs;
+            if (fRenderTick > m_fLastRenderTick)
+            {
+                m_fLastRenderTick = fRenderTick;
+            }
+            return m_fLastRenderTick;
+        }
+
+        /**
+        * Same as sampleAt(renderTick(nNowUs), out).
+        */
+        JitterSample sample(int64_t nNowUs, State& out)
+        {
+            return sampleAt(renderTick(nNowUs), out);
+        }
+
+        /**
+        * Gets the state at the given render time.
+        * Complexity: O(log n).
+        *
+        * @param fRenderTick Render time in fractional server ticks, e.g. as returned by renderTick() of this or another buffer
+        *                    receiving the same snapshot stream.
+        * @param out         Set to the state at the given render time, unless the buffer is empty.
+        */
+        JitterSample sampleAt(double fRenderTick, State& out) const
+        {
+            const size_t nSize = m_states.size();
+            if (nSize == 0)
+            {
+                return JitterSample::None;
+            }
+
+            // first state after render time
+            size_t iLow = 0;
+            size_t iHigh = nSize;
+            while (iLow < iHigh)
+            {
+                const size_t iMid = iLow + (iHigh - iLow) / 2;
+                if (static_cast<double>(m_states.at(iMid).nTick) <= fRenderTick)
+                {
+                    iLow = iMid + 1;
+                }
+                else
+                {
+                    iHigh = iMid;
+                }
+            }
+
+            if (iLow == 0)
+            {
+                out = m_states.at(0).state;
+                return JitterSample::Clamped;
+            }
+
+            if (iLow < nSize)
+            {
+                const Entry& from = m_states.at(iLow - 1);
+                const Entry& to = m_states.at(iLow);
+                const double t = (fRenderTick - static_cast<double>(from.nTick)) / static_cast<double>(to.nTick - from.nTick);
+                out = m_interpolator(from.state, to.state, static_cast<float>(t));
+                return JitterSample::Interpolated;
+            }
+
+            const Entry& newest = m_states.at(nSize - 1);
+            if (fRenderTick == static_cast<double>(newest.nTick))
+            {
+                out = newest.state;
+                return JitterSample::Interpolated;
+            }
+            if ((nSize < 2) || (m_fMaxExtrapolationUs <= 0.0))
+            {
+                out = newest.state;
+                return JitterSample::Clamped;
+            }
+
+            const Entry& previous = m_states.at(nSize - 2);
+            const double fExtrapolatedTick = std::fmin(fRenderTick, static_cast<double>(newest.nTick) + m_fMaxExtrapolationUs / m_fTickUs);
+            const double t = (fExtrapolatedTick - static_cast<double>(previous.nTick)) / static_cast<double>(newest.nTick - previous.nTick);
+            out = m_interpolator(previous.state, newest.state, static_cast<float>(t));
+            return JitterSample::Extrapolated;
+        }
+
+        /**
+        * Samples many buffers at the same render time, e.g. all remote entities of the same snapshot stream.
+        *
+        * @param pBuffers    Array of nCount buffers.
+        * @param pOut        Array of nCount states, each set as by sampleAt().
+        * @param pResults    Optional array of nCount results.
+        *
+        * @return Number of buffers which were not empty.
+        */
+        static size_t sampleBatch(
+            const JitterBuffer* pBuffers, size_t nCount, double fRenderTick,
+            State* pOut, JitterSample* pResults = nullptr)
+        {
+            size_t nSampled = 0;
+            for (size_t i = 0; i < nCount; i++)
+            {
+                const JitterSample result = pBuffers[i].sampleAt(fRenderTick, pOut[i]);
+                if (result != JitterSample::None)
+                {
+                    nSampled++;
+                }
+                if (pResults)
+                {
+                    pResults[i] = result;
+                }
+            }
+            return nSampled;
+        }
+
+        /**
+        * @return Current delay of render time behind the estimated server time, in microseconds.
+        */
+        double delayUs() const
+        {
+            return m_fBaseDelayUs + m_fJitterMultiplier * m_fJitterUs;
+        }
+
+        /**
+        * @return Smoothed variation of transit time of received states, in microseconds.
+        */
+        double jitterUs() const
+        {
+            return m_fJitterUs;
+        }
+
+        /**
+        * Sets how many times the jitter is added to the base delay. Bigger value means fewer late states but more latency.
+        * Default is 3.
+        */
+        void setJitterMultiplier(double fMultiplier)
+        {
+            m_fJitterMultiplier = fMultiplier;
+        }
+
+        void setBaseDelay(int64_t nBaseDelayUs)
+        {
+            m_fBaseDelayUs = static_cast<double>(nBaseDelayUs);
+        }
+
+        void setMaxExtrapolation(int64_t nMaxExtrapolationUs)
+        {
+            m_fMaxExtrapolationUs = static_cast<double>(nMaxExtrapolationUs);
+        }
+
+        /**
+        * @return Number of stored states.
+        */
+        const size_t& size() const
+        {
+            return m_states.size();
+        }
+
+        /**
+        * @return True if no state is stored, false otherwise.
+        */
+        bool empty() const
+        {
+            return m_states.empty();
+        }
+
+        /**
+        * @return Tick of the newest stored state.
+        *         Throws exception if the buffer is empty.
+        */
+        uint64_t newestTick() const
+        {
+            if (empty())
+            {
+                throw std::runtime_error("Container is empty!");
+            }
+
+            return m_states.at(m_states.size() - 1).nTick;
+        }
+
+    private:
+        /** Weight of a new sample in the smoothed transit time and jitter, same as RTP uses for jitter. */
+        static constexpr double SmoothingFactor = 1.0 / 16.0;
+
+        struct Entry
+        {
+            uint64_t nTick = 0;
+            State state{};
+        };
+
+        FixFIFO<Entry> m_states;
+        Interpolator m_interpolator;
+        double m_fTickUs;
+        double m_fBaseDelayUs;
+        double m_fMaxExtrapolationUs;
+        double m_fJitterMultiplier = 3.0;
+
+        bool m_bHasTiming = false;
+        double m_fTransitUs = 0.0;       /**< Smoothed arrival time minus server time of received states, including clock offset. */
+        double m_fLastTransitUs = 0.0;
+        double m_fJitterUs = 0.0;
+        double m_fLastRenderTick = 0.0;
+
+        void updateTiming(uint64_t nTick, int64_t nArrivalUs)
+        {
+            const double fTransitUs = static_cast<double>(nArrivalUs) - static_cast<double>(nTick) * m_fTickUs;
+            if (!m_bHasTiming)
+            {
+                m_bHasTiming = true;
+                m_fTransitUs = fTransitUs;
+                m_fLastTransitUs = fTransitUs;
+                return;
+            }
+
+            m_fJitterUs += (std::fabs(fTransitUs - m_fLastTransitUs) - m_fJitterUs) * SmoothingFactor;
+            m_fTransitUs += (fTransitUs - m_fTransitUs) * SmoothingFactor;
+            m_fLastTransitUs = fTransitUs;
+        }
+
+    }; // class JitterBuffer
+
+    template <typename State, typename Interpolator>
+    constexpr double JitterBuffer<State, Interpolator>::SmoothingFactor;
+
+} // namespace
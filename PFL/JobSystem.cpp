@@ -0,0 +1,553 @@
+/*
+    ###################################################################################
+    JobSystem.cpp
+    Work-stealing thread pool with job counters, continuations and parallel for.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include "JobSystem.h"
+
+#include <utility>
+
+
+namespace
+{
+    /** Number of unsuccessful job searches an idle worker makes before going to sleep. */
+    constexpr int nIdleSpins = 32;
+
+    /** Number of job slots taken from or given back to the job pool at once by each thread. */
+    constexpr size_t nJobCacheBatch = 32;
+
+    /**
+        xorshift32 random generator for picking steal victims, with per-thread state.
+    */
+    uint32_t nextRandom()
+    {
+        static thread_local uint32_t nState = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+        nState ^= nState << 13;
+        nState ^= nState >> 17;
+        nState ^= nState << 5;
+        return nState;
+    } // nextRandom()
+
+} // namespace
+
+
+struct pfl::JobSystem::Worker
+{
+    Worker(JobSystem& system, size_t nDequeCapacity) :
+        pSystem(&system),
+        deque(nDequeCapacity),
+        jobCache(system.m_jobPool, nJobCacheBatch)
+    {
+    }
+
+    JobSystem* const pSystem;
+    WorkStealingDeque deque;
+    ObjectPool<detail::Job>::ThreadCache jobCache;
+};
+
+
+thread_local pfl::JobSystem::Worker* pfl::JobSystem::s_pCurrentWorker = nullptr;
+
+
+// ############################### PUBLIC ################################
+
+
+pfl::JobSystem::JobSystem(size_t nWorkers, size_t nDequeCapacity, size_t nJobCapacity) :
+    m_jobPool(nJobCapacity),
+    m_injectionQueue(nJobCapacity)
+{
+    if (nWorkers == 0)
+    {
+        const unsigned int nHwThreads = std::thread::hardware_concurrency();
+        nWorkers = (nHwThreads > 1) ? (nHwThreads - 1) : 1;
+    }
+
+    size_t nRoundedDequeCapacity = 2;
+    while (nRoundedDequeCapacity < nDequeCapacity)
+    {
+        nRoundedDequeCapacity *= 2;
+    }
+
+    // no allocation when submitting jobs later
+    m_jobPool.preallocate();
+    m_pExternalJobCache.reset(new ObjectPool<detail::Job>::ThreadCache(m_jobPool, nJobCacheBatch));
+
+    for (size_t i = 0; i < nWorkers; i++)
+    {
+        m_workers.emplace_back(new Worker(*this, nRoundedDequeCapacity));
+    }
+    for (size_t i = 0; i < nWorkers; i++)
+    {
+        m_threads.emplace_back(&JobSystem::workerMain, this, m_workers[i].get());
+    }
+} // JobSystem()
+
+
+/**
+    Stops the worker threads after all submitted jobs have been executed.
+*/
+pfl::JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_bStop.store(true);
+    }
+    m_sleepCv.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+
+    // job caches must be destroyed before the job pool
+    m_workers.clear();
+    m_pExternalJobCache.reset();
+} // ~JobSystem()
+
+
+/**
+    Submits a job to be executed by any thread.
+    When called from a worker thread, the job is pushed to the deque of that worker, otherwise to the injection queue.
+    If the queue is full or the job pool is exhausted, the job is executed right here.
+
+    @param job      The job.
+    @param pCounter If not null, it is incremented now and decremented when the job has finished.
+*/
+void pfl::JobSystem::run(JobFunction job, JobCounter* pCounter)
+{
+    detail::Job* const pJob = allocateJob(std::move(job), pCounter);
+    if (!pJob)
+    {
+        job();
+        return;
+    }
+    submit(pJob);
+} // run()
+
+
+/**
+    Submits a job to be executed after all jobs of the given counter have finished, without blocking the caller.
+    If the dependency is already done, this is the same as run().
+    If the job pool is exhausted, this waits for the dependency and executes the job right here.
+
+    @param dependency Counter to wait for.
+    @param job        The job.
+    @param pCounter   If not null, it is incremented now and decremented when the job has finished.
+*/
+void pfl::JobSystem::runAfter(JobCounter& dependency, JobFunction job, JobCounter* pCounter)
+{
+    detail::Job* const pJob = allocateJob(std::move(job), pCounter);
+    if (!pJob)
+    {
+        wait(dependency);
+        job();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (dependency.m_nPending.load(std::memory_order_acquire) > 0)
+        {
+            dependency.m_continuations.push_back(pJob);
+            return;
+        }
+    }
+    submit(pJob);
+} // runAfter()
+
+
+/**
+    Executes queued jobs until all jobs of the given counter have finished.
+    Can be called from jobs as well.
+*/
+void pfl::JobSystem::wait(JobCounter& counter)
+{
+    Worker* const pWorker = currentWorker();
+    while (!counter.isDone())
+    {
+        detail::Job* const pJob = findJob(pWorker);
+        if (pJob)
+        {
+            execute(pJob);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // the thread finishing the last job might still hold the mutex, the counter must not be destroyed before it releases it
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+} // wait()
+
+
+/**
+    Executes func over [nBegin, nEnd) in parallel, split into subranges, and returns when all of them are done.
+    Splitting is adaptive (lazy binary splitting): a thread processing a range splits off its second half as a new job only if
+    its own queue is empty, i.e. when other threads are likely to be idle; otherwise it processes the range grain by grain.
+    So the number of jobs adapts to the actual load balance instead of a fixed chunk count.
+
+    @param nBegin     First index.
+    @param nEnd       One past the last index.
+    @param func       Function processing the subrange [nBegin, nEnd). Invoked concurrently from multiple threads.
+    @param nGrainSize Minimum number of indices processed by a single invocation of func, except for the last one of a range.
+*/
+void pfl::JobSystem::parallelFor(size_t nBegin, size_t nEnd, const RangeFunction& func, size_t nGrainSize)
+{
+    if (nBegin >= nEnd)
+    {
+        return;
+    }
+
+    JobCounter counter;
+    processRange(nBegin, nEnd, func, (nGrainSize > 0) ? nGrainSize : 1, counter);
+    wait(counter);
+} // parallelFor()
+
+
+// ############################## PROTECTED ##############################
+
+
+// ############################### PRIVATE ###############################
+
+
+pfl::JobSystem::WorkStealingDeque::WorkStealingDeque(size_t capacity) :
+    m_buffer(new std::atomic<detail::Job*>[capacity]),
+    m_nMask(static_cast<int64_t>(capacity) - 1)
+{
+} // WorkStealingDeque()
+
+
+/**
+    Pushes a job to the bottom. Owner thread only.
+    @return False if the deque is full.
+*/
+bool pfl::JobSystem::WorkStealingDeque::push(detail::Job* pJob)
+{
+    const int64_t b = m_nBottom.load(std::memory_order_relaxed);
+    const int64_t t = m_nTop.load(std::memory_order_acquire);
+    if (b - t > m_nMask)
+    {
+        return false;
+    }
+
+    m_buffer[b & m_nMask].store(pJob, std::memory_order_relaxed);
+    // publishes the job to thieves
+    m_nBottom.store(b + 1, std::memory_order_release);
+    return true;
+} // push()
+
+
+/**
+    Pops a job from the bottom. Owner thread only.
+    @return The popped job, or null if the deque is empty or the last job has just been stolen.
+*/
+pfl::detail::Job* pfl::JobSystem::WorkStealingDeque::pop()
+{
+    const int64_t b = m_nBottom.load(std::memory_order_relaxed) - 1;
+    // seq_cst store-then-load: either we see the thief's top increment, or the thief sees our bottom decrement
+    m_nBottom.store(b, std::memory_order_seq_cst);
+    int64_t t = m_nTop.load(std::memory_order_seq_cst);
+
+    if (t > b)
+    {
+        // empty
+        m_nBottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    detail::Job* pJob = m_buffer[b & m_nMask].load(std::memory_order_relaxed);
+    if (t == b)
+    {
+        // last job: race against thieves for it
+        if (!m_nTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            pJob = nullptr;
+        }
+        m_nBottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return pJob;
+} // pop()
+
+
+/**
+    Steals a job from the top. Any thread.
+    @return The stolen job, or null if the deque is empty or another thread has won the race for the top job.
+*/
+pfl::detail::Job* pfl::JobSystem::WorkStealingDeque::steal()
+{
+    int64_t t = m_nTop.load(std::memory_order_seq_cst);
+    const int64_t b = m_nBottom.load(std::memory_order_seq_cst);
+    if (t >= b)
+    {
+        return nullptr;
+    }
+
+    // the owner cannot overwrite this slot until top is incremented, so reading it before the CAS is safe
+    detail::Job* const pJob = m_buffer[t & m_nMask].load(std::memory_order_relaxed);
+    if (!m_nTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        return nullptr;
+    }
+    return pJob;
+} // steal()
+
+
+/**
+    Tells if the deque looks empty. Exact only when called by the owner thread.
+*/
+bool pfl::JobSystem::WorkStealingDeque::empty() const
+{
+    return m_nBottom.load(std::memory_order_relaxed) <= m_nTop.load(std::memory_order_relaxed);
+} // empty()
+
+
+/**
+    @return The worker of this job system running on the current thread, or null if the current thread is not such a worker.
+*/
+pfl::JobSystem::Worker* pfl::JobSystem::currentWorker() const
+{
+    return (s_pCurrentWorker && (s_pCurrentWorker->pSystem == this)) ? s_pCurrentWorker : nullptr;
+} // currentWorker()
+
+
+/**
+    Takes a job slot from the job cache of the current thread, and increments the counter.
+    @return The new job, or null if the job pool is exhausted, in which case job is left untouched.
+*/
+pfl::detail::Job* pfl::JobSystem::allocateJob(JobFunction&& job, JobCounter* pCounter)
+{
+    Worker* const pWorker = currentWorker();
+    detail::Job* pJob = nullptr;
+    if (pWorker)
+    {
+        pJob = pWorker->jobCache.allocate();
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_externalMutex);
+        pJob = m_pExternalJobCache->allocate();
+    }
+
+    if (!pJob)
+    {
+        return nullptr;
+    }
+
+    pJob->function = std::move(job);
+    pJob->pCounter = pCounter;
+    if (pCounter)
+    {
+        pCounter->m_nPending.fetch_add(1, std::memory_order_relaxed);
+    }
+    return pJob;
+} // allocateJob()
+
+
+void pfl::JobSystem::releaseJob(detail::Job* pJob)
+{
+    Worker* const pWorker = currentWorker();
+    if (pWorker)
+    {
+        pWorker->jobCache.release(pJob);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_externalMutex);
+        m_pExternalJobCache->release(pJob);
+    }
+} // releaseJob()
+
+
+/**
+    Queues the given job, or executes it right here if the queue is full. Wakes up a sleeping worker if any.
+*/
+void pfl::JobSystem::submit(detail::Job* pJob)
+{
+    // counted before pushing, so a worker never goes to sleep while a job it could take is queued
+    m_nQueued.fetch_add(1, std::memory_order_seq_cst);
+
+    bool bPushed = false;
+    Worker* const pWorker = currentWorker();
+    if (pWorker)
+    {
+        bPushed = pWorker->deque.push(pJob);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_externalMutex);
+        bPushed = m_injectionQueue.push_back(pJob);
+    }
+
+    if (!bPushed)
+    {
+        m_nQueued.fetch_sub(1, std::memory_order_relaxed);
+        execute(pJob);
+        return;
+    }
+
+    if (m_nSleeping.load(std::memory_order_seq_cst) > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_sleepCv.notify_one();
+    }
+} // submit()
+
+
+void pfl::JobSystem::execute(detail::Job* pJob)
+{
+    pJob->function();
+    JobCounter* const pCounter = pJob->pCounter;
+    // released before finishing, so continuations can reuse the slot
+    releaseJob(pJob);
+    finish(pCounter);
+} // execute()
+
+
+/**
+    Decrements the given counter, and submits its continuations if it has become done.
+*/
+void pfl::JobSystem::finish(JobCounter* pCounter)
+{
+    if (!pCounter)
+    {
+        return;
+    }
+
+    std::vector<detail::Job*> continuations;
+    {
+        // locked so that runAfter() either sees the counter done, or registers its continuation before we take them
+        std::lock_guard<std::mutex> lock(pCounter->m_mutex);
+        if (pCounter->m_nPending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            continuations.swap(pCounter->m_continuations);
+        }
+    }
+
+    for (detail::Job* const pJob : continuations)
+    {
+        submit(pJob);
+    }
+} // finish()
+
+
+/**
+    Looks for a job: first in the own deque of the given worker, then in other workers' deques, then in the injection queue.
+    @param pWorker The worker of the current thread, or null for non-worker threads.
+    @return The found job, or null if none found.
+*/
+pfl::detail::Job* pfl::JobSystem::findJob(Worker* pWorker)
+{
+    if (m_nQueued.load(std::memory_order_seq_cst) == 0)
+    {
+        return nullptr;
+    }
+
+    detail::Job* pJob = pWorker ? pWorker->deque.pop() : nullptr;
+
+    if (!pJob)
+    {
+        const size_t nWorkers = m_workers.size();
+        const size_t iFirstVictim = nextRandom() % nWorkers;
+        for (size_t i = 0; !pJob && (i < nWorkers); i++)
+        {
+            Worker* const pVictim = m_workers[(iFirstVictim + i) % nWorkers].get();
+            if (pVictim != pWorker)
+            {
+                pJob = pVictim->deque.steal();
+            }
+        }
+    }
+
+    if (!pJob)
+    {
+        std::lock_guard<std::mutex> lock(m_externalMutex);
+        if (!m_injectionQueue.empty())
+        {
+            pJob = m_injectionQueue.pop_front();
+        }
+    }
+
+    if (pJob)
+    {
+        m_nQueued.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return pJob;
+} // findJob()
+
+
+void pfl::JobSystem::workerMain(Worker* pWorker)
+{
+    s_pCurrentWorker = pWorker;
+
+    int nFailedSearches = 0;
+    while (true)
+    {
+        detail::Job* const pJob = findJob(pWorker);
+        if (pJob)
+        {
+            execute(pJob);
+            nFailedSearches = 0;
+            continue;
+        }
+
+        if (m_bStop.load())
+        {
+            break;
+        }
+
+        if (++nFailedSearches < nIdleSpins)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_nSleeping.fetch_add(1, std::memory_order_seq_cst);
+        m_sleepCv.wait(lock, [this]() { return (m_nQueued.load(std::memory_order_seq_cst) > 0) || m_bStop.load(); });
+        m_nSleeping.fetch_sub(1, std::memory_order_relaxed);
+        nFailedSearches = 0;
+    }
+
+    s_pCurrentWorker = nullptr;
+} // workerMain()
+
+
+/**
+    Tells if the current thread should split off half of its range as a new job.
+    Workers split when their own deque is empty. Other threads split when fewer jobs are queued than there are workers.
+*/
+bool pfl::JobSystem::shouldSplit() const
+{
+    const Worker* const pWorker = currentWorker();
+    return pWorker ? pWorker->deque.empty() : (m_nQueued.load(std::memory_order_relaxed) < m_workers.size());
+} // shouldSplit()
+
+
+void pfl::JobSystem::processRange(size_t nBegin, size_t nEnd, const RangeFunction& func, size_t nGrainSize, JobCounter& counter)
+{
+    while (nEnd - nBegin > nGrainSize)
+    {
+        if (shouldSplit())
+        {
+            const size_t nMiddle = nBegin + (nEnd - nBegin) / 2;
+            run([this, &func, &counter, nMiddle, nEnd, nGrainSize]()
+                {
+                    processRange(nMiddle, nEnd, func, nGrainSize, counter);
+                },
+                &counter);
+            nEnd = nMiddle;
+        }
+        else
+        {
+            func(nBegin, nBegin + nGrainSize);
+            nBegin += nGrainSize;
+        }
+    }
+    func(nBegin, nEnd);
+} // processRange()
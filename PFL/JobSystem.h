@@ -0,0 +1,194 @@
+#pragma once
+
+/*
+    ###################################################################################
+    JobSystem.h
+    Work-stealing thread pool with job counters, continuations and parallel for.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FixFIFO.h"
+#include "ObjectPool.h"
+
+namespace pfl
+{
+    class JobCounter;
+
+    namespace detail
+    {
+        struct Job
+        {
+            std::function<void()> function;
+            JobCounter* pCounter;  /**< Decremented when function has returned. Can be null. */
+        };
+    }
+
+    /**
+    * Counts unfinished jobs submitted with it, so they can be waited for, or followed by continuation jobs.
+    * A counter can be reused after it has become done.
+    * A counter must not be destroyed while jobs submitted with it are unfinished.
+    */
+    class JobCounter
+    {
+
+    public:
+
+        JobCounter() = default;
+        ~JobCounter() = default;
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+        JobCounter(JobCounter&&) = delete;
+        JobCounter& operator=(JobCounter&&) = delete;
+
+        /**
+        * @return Number of unfinished jobs.
+        */
+        uint32_t pending() const
+        {
+            return m_nPending.load(std::memory_order_acquire);
+        }
+
+        /**
+        * @return True if all jobs submitted with this counter are finished. Results of these jobs are visible then.
+        */
+        bool isDone() const
+        {
+            return pending() == 0;
+        }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> m_nPending{ 0 };
+        std::mutex m_mutex;                           /**< Guards m_continuations and the transition to done. */
+        std::vector<detail::Job*> m_continuations;    /**< Jobs to be submitted when this becomes done. */
+
+    }; // class JobCounter
+
+    /**
+    * Work-stealing thread pool.
+    *
+    * Each worker thread has a fixed-capacity Chase-Lev deque: the worker pushes and pops jobs at the bottom without locking,
+    * idle workers steal from the top of other workers' deques. Jobs submitted by non-worker threads go to a shared injection queue.
+    * If a queue is full, or the job pool is exhausted, the job is executed inline by the submitting thread, so submission never fails.
+    *
+    * Waiting for a JobCounter executes queued jobs in the meantime, so waiting from a job does not deadlock and the main thread
+    * contributes to the work.
+    *
+    * Jobs must not throw.
+    * All submitted jobs are executed before the destructor returns.
+    */
+    class JobSystem
+    {
+
+    public:
+
+        typedef std::function<void()> JobFunction;
+        typedef std::function<void(size_t nBegin, size_t nEnd)> RangeFunction;
+
+        /**
+        * @param nWorkers       Number of worker threads. 0 means one less than the number of hardware threads, but at least 1,
+        *                       as the main thread also executes jobs while waiting.
+        * @param nDequeCapacity Capacity of each worker's deque. Rounded up to a power of 2.
+        * @param nJobCapacity   Maximum number of jobs submitted but not yet finished.
+        */
+        JobSystem(size_t nWorkers = 0, size_t nDequeCapacity = 1024, size_t nJobCapacity = 4096);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+        JobSystem(JobSystem&&) = delete;
+        JobSystem& operator=(JobSystem&&) = delete;
+
+        void run(JobFunction job, JobCounter* pCounter = nullptr);         /**< Submits a job. */
+        void runAfter(
+            JobCounter& dependency,
+            JobFunction job,
+            JobCounter* pCounter = nullptr);                               /**< Submits a job to be started after the given counter becomes done. */
+        void wait(JobCounter& counter);                                    /**< Executes jobs until the given counter becomes done. */
+        void parallelFor(
+            size_t nBegin, size_t nEnd,
+            const RangeFunction& func,
+            size_t nGrainSize = 1);                                        /**< Executes func over subranges of [nBegin, nEnd) in parallel. */
+
+        /**
+        * @return Number of worker threads.
+        */
+        size_t numWorkers() const
+        {
+            return m_workers.size();
+        }
+
+    private:
+
+        /**
+        * Fixed-capacity Chase-Lev work-stealing deque of job pointers.
+        * push() and pop() are called only by the owner thread, steal() by any thread.
+        */
+        class WorkStealingDeque
+        {
+
+        public:
+
+            explicit WorkStealingDeque(size_t capacity);
+
+            bool push(detail::Job* pJob);
+            detail::Job* pop();
+            detail::Job* steal();
+            bool empty() const;
+
+        private:
+            std::unique_ptr<std::atomic<detail::Job*>[]> m_buffer;
+            const int64_t m_nMask;
+            std::atomic<int64_t> m_nTop{ 0 };     /**< Next index to steal from. */
+            char m_padding[64];                   /**< Keeps m_nTop and m_nBottom on separate cache lines. */
+            std::atomic<int64_t> m_nBottom{ 0 };  /**< Next index to push to. */
+
+        }; // class WorkStealingDeque
+
+        struct Worker;
+
+        static thread_local Worker* s_pCurrentWorker;  /**< The worker running on the current thread, null for non-worker threads. */
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::vector<std::thread> m_threads;
+
+        ObjectPool<detail::Job> m_jobPool;
+        std::mutex m_externalMutex;                                         /**< Guards m_pExternalJobCache and m_injectionQueue. */
+        std::unique_ptr<ObjectPool<detail::Job>::ThreadCache> m_pExternalJobCache;
+        FixFIFO<detail::Job*> m_injectionQueue;                             /**< Jobs submitted by non-worker threads. */
+
+        std::atomic<uint32_t> m_nQueued{ 0 };                               /**< Number of jobs in all queues. */
+        std::atomic<uint32_t> m_nSleeping{ 0 };
+        std::atomic<bool> m_bStop{ false };
+        std::mutex m_sleepMutex;
+        std::condition_variable m_sleepCv;
+
+        Worker* currentWorker() const;
+        detail::Job* allocateJob(JobFunction&& job, JobCounter* pCounter);
+        void releaseJob(detail::Job* pJob);
+        void submit(detail::Job* pJob);
+        void execute(detail::Job* pJob);
+        void finish(JobCounter* pCounter);
+        detail::Job* findJob(Worker* pWorker);
+        void workerMain(Worker* pWorker);
+        bool shouldSplit() const;
+        void processRange(size_t nBegin, size_t nEnd, const RangeFunction& func, size_t nGrainSize, JobCounter& counter);
+
+    }; // class JobSystem
+
+} // namespace
@@ -0,0 +1,318 @@
+/*
+    ###################################################################################
+    MappedFile.cpp
+    Read-only memory-mapped file with read-into-buffer fallback, and background file prefetching.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <utility>
+
+#ifdef _WIN32
+#include "winproof88.h"
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+// ############################### PUBLIC ################################
+
+
+pfl::MappedFile::~MappedFile()
+{
+    close();
+}
+
+
+pfl::MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+
+pfl::MappedFile& pfl::MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        m_buffer = std::move(other.m_buffer);
+        m_nSize = other.m_nSize;
+        m_bOpen = other.m_bOpen;
+        m_bMapped = other.m_bMapped;
+        // moving the vector keeps its heap block, but let's not rely on that for the non-mapped case
+        m_pData = m_bMapped ? other.m_pData : m_buffer.data();
+
+        other.m_pData = nullptr;
+        other.m_nSize = 0;
+        other.m_bOpen = false;
+        other.m_bMapped = false;
+    }
+    return *this;
+}
+
+
+/**
+    Maps or reads the whole content of the given file.
+    Any previously opened content is released first.
+
+    @param path        Path to the file.
+    @param bSequential Access pattern hint for the OS: true if the content will be read mostly from beginning to end,
+                       false if it will be accessed randomly. Mapped pages are also requested to be read ahead in both cases.
+
+    @return True on success, false if the file cannot be opened or read.
+*/
+bool pfl::MappedFile::open(const char* path, bool bSequential)
+{
+    close();
+
+#ifdef _WIN32
+    const HANDLE hFile = CreateFileA(
+        path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | (bSequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS),
+        NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize) || (static_cast<unsigned long long>(fileSize.QuadPart) > static_cast<size_t>(-1)))
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+    m_nSize = static_cast<size_t>(fileSize.QuadPart);
+
+    if (m_nSize >= MinMappedSize)
+    {
+        // the view keeps the mapping alive, both handles can be closed right after mapping
+        const HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (hMapping != NULL)
+        {
+            m_pData = static_cast<const char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(hMapping);
+            m_bMapped = (m_pData != nullptr);
+        }
+    }
+
+    if (!m_bMapped)
+    {
+        m_buffer.resize(m_nSize);
+        size_t nRead = 0;
+        while (nRead < m_nSize)
+        {
+            DWORD nChunk = 0;
+            const DWORD nToRead = static_cast<DWORD>(std::min<size_t>(m_nSize - nRead, 0x40000000u));
+            if (!ReadFile(hFile, m_buffer.data() + nRead, nToRead, &nChunk, NULL) || (nChunk == 0))
+            {
+                break;
+            }
+            nRead += nChunk;
+        }
+        if (nRead != m_nSize)
+        {
+            CloseHandle(hFile);
+            m_buffer.clear();
+            m_nSize = 0;
+            return false;
+        }
+        m_pData = m_buffer.data();
+    }
+
+    CloseHandle(hFile);
+#else
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode))
+    {
+        ::close(fd);
+        return false;
+    }
+    m_nSize = static_cast<size_t>(st.st_size);
+
+    if (m_nSize >= MinMappedSize)
+    {
+        // the mapping keeps a reference to the file, fd can be closed right after mapping
+        void* const pMapped = mmap(nullptr, m_nSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pMapped != MAP_FAILED)
+        {
+            madvise(pMapped, m_nSize, bSequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+            madvise(pMapped, m_nSize, MADV_WILLNEED);
+            m_pData = static_cast<const char*>(pMapped);
+            m_bMapped = true;
+        }
+    }
+
+    if (!m_bMapped)
+    {
+#ifdef POSIX_FADV_SEQUENTIAL
+        if (bSequential)
+        {
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        }
+#endif
+        m_buffer.resize(m_nSize);
+        size_t nRead = 0;
+        while (nRead < m_nSize)
+        {
+            const ssize_t nChunk = ::read(fd, m_buffer.data() + nRead, m_nSize - nRead);
+            if (nChunk < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                break;
+            }
+            if (nChunk == 0)
+            {
+                break;
+            }
+            nRead += static_cast<size_t>(nChunk);
+        }
+        if (nRead != m_nSize)
+        {
+            ::close(fd);
+            m_buffer.clear();
+            m_nSize = 0;
+            return false;
+        }
+        m_pData = m_buffer.data();
+    }
+
+    ::close(fd);
+#endif
+
+    m_bOpen = true;
+    return true;
+} // open()
+
+
+/**
+    Releases the content.
+    Pointers returned by data() become invalid.
+*/
+void pfl::MappedFile::close()
+{
+    if (m_bMapped && m_pData)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_pData);
+#else
+        munmap(const_cast<char*>(m_pData), m_nSize);
+#endif
+    }
+
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_pData = nullptr;
+    m_nSize = 0;
+    m_bOpen = false;
+    m_bMapped = false;
+} // close()
+
+
+pfl::FilePrefetcher::~FilePrefetcher()
+{
+    wait();
+}
+
+
+/**
+    Starts prefetching the given files on a background thread.
+    If a previous prefetch is still running, this waits for it to finish first.
+
+    @param paths Files to be prefetched, in the order they are going to be needed.
+*/
+void pfl::FilePrefetcher::start(std::vector<std::string> paths)
+{
+    wait();
+    m_nProcessed.store(0, std::memory_order_relaxed);
+    m_thread = std::thread([this, paths = std::move(paths)]()
+        {
+            for (const auto& path : paths)
+            {
+                prefetch(path.c_str());
+                m_nProcessed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+} // start()
+
+
+/**
+    Blocks until prefetching is finished.
+    Returns immediately if nothing has been started.
+*/
+void pfl::FilePrefetcher::wait()
+{
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+} // wait()
+
+
+/**
+    Synchronously warms the OS file cache for the given file.
+    On Linux, this only asks the kernel to read ahead the whole file. Elsewhere the file is read through a small scratch buffer.
+
+    @return True if the file could be opened, false otherwise.
+*/
+bool pfl::FilePrefetcher::prefetch(const char* path)
+{
+#ifdef _WIN32
+    const HANDLE hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    static constexpr DWORD nScratchSize = 64 * 1024;
+    std::vector<char> scratch(nScratchSize);
+    DWORD nChunk = 0;
+    while (ReadFile(hFile, scratch.data(), nScratchSize, &nChunk, NULL) && (nChunk > 0))
+    {
+    }
+
+    CloseHandle(hFile);
+#else
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+#ifdef POSIX_FADV_WILLNEED
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#else
+    static constexpr size_t nScratchSize = 64 * 1024;
+    std::vector<char> scratch(nScratchSize);
+    while (::read(fd, scratch.data(), nScratchSize) > 0)
+    {
+    }
+#endif
+
+    ::close(fd);
+#endif
+    return true;
+} // prefetch()
+
+
+// ############################## PROTECTED ##############################
+
+
+// ############################### PRIVATE ###############################
@@ -0,0 +1,136 @@
+#pragma once
+
+/*
+    ###################################################################################
+    MappedFile.h
+    Read-only memory-mapped file with read-into-buffer fallback, and background file prefetching.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+namespace pfl
+{
+    /**
+    * Read-only view of a whole file's content.
+    * The file is memory-mapped if possible, so content is not copied and pages are loaded on demand by the OS.
+    * Small files and files that cannot be mapped are read into an internal buffer instead, the interface is the same in both cases.
+    * Content stays valid until close() or destruction.
+    */
+    class MappedFile
+    {
+
+    public:
+
+        static constexpr size_t MinMappedSize = 16 * 1024;  /**< Files smaller than this are read into buffer since mapping them costs more than reading. */
+
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool open(const char* path, bool bSequential = true);  /**< Maps or reads the whole content of the given file. */
+        void close();                                           /**< Releases the content. */
+
+        /**
+        * @return True if a file is successfully opened, false otherwise.
+        */
+        bool isOpen() const
+        {
+            return m_bOpen;
+        }
+
+        /**
+        * @return True if the content is memory-mapped, false if it was read into buffer or nothing is opened.
+        */
+        bool isMapped() const
+        {
+            return m_bMapped;
+        }
+
+        /**
+        * @return Pointer to the first byte of the content. Not null-terminated. Can be nullptr if the file is empty or nothing is opened.
+        */
+        const char* data() const
+        {
+            return m_pData;
+        }
+
+        /**
+        * @return Size of the content in bytes.
+        */
+        size_t size() const
+        {
+            return m_nSize;
+        }
+
+#if __cplusplus >= 201703L
+        /**
+        * @return The content as a string view.
+        */
+        std::string_view view() const
+        {
+            return std::string_view(m_pData, m_nSize);
+        }
+#endif
+
+    private:
+        const char* m_pData = nullptr;  /**< Either the mapped address or m_buffer.data(). */
+        size_t m_nSize = 0;
+        bool m_bOpen = false;
+        bool m_bMapped = false;
+        std::vector<char> m_buffer;     /**< Content if the file is not mapped. */
+
+    }; // class MappedFile
+
+    /**
+    * Warms the OS file cache for a list of files on a background thread, so later MappedFile::open() calls do not block on disk I/O.
+    * Files that cannot be opened are silently skipped.
+    */
+    class FilePrefetcher
+    {
+
+    public:
+
+        FilePrefetcher() = default;
+        ~FilePrefetcher();
+
+        FilePrefetcher(const FilePrefetcher&) = delete;
+        FilePrefetcher& operator=(const FilePrefetcher&) = delete;
+        FilePrefetcher(FilePrefetcher&&) = delete;
+        FilePrefetcher& operator=(FilePrefetcher&&) = delete;
+
+        void start(std::vector<std::string> paths);  /**< Starts prefetching the given files on a background thread. */
+        void wait();                                  /**< Blocks until prefetching is finished. */
+
+        /**
+        * @return Number of files processed so far by the current or last prefetch, including skipped ones.
+        */
+        size_t numProcessed() const
+        {
+            return m_nProcessed.load(std::memory_order_relaxed);
+        }
+
+        static bool prefetch(const char* path);      /**< Synchronously warms the OS file cache for the given file. */
+
+    private:
+        std::thread m_thread;
+        std::atomic<size_t> m_nProcessed{ 0 };
+
+    }; // class FilePrefetcher
+
+} // namespace
@@ -0,0 +1,398 @@
+/*
+    ###################################################################################
+    Metrics.cpp
+    Registry of named counters and gauges with per-thread sharded counters and periodic snapshot export.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include "Metrics.h"
+
+#include <cstdio>
+#include <stdexcept>
+
+
+namespace
+{
+    /** Number of counters worth a cache line, used as padding on both ends of each shard. */
+    constexpr size_t nShardPadding = 64 / sizeof(std::atomic<uint64_t>);
+
+    /** Source of unique registry ids, 0 is reserved for empty cache entries. */
+    std::atomic<uint64_t> nNextRegistryId(1);
+
+    /**
+        Appends the given string as a JSON string literal.
+    */
+    void appendJsonString(std::string& sOut, const std::string& str)
+    {
+        sOut += '"';
+        for (const char c : str)
+        {
+            switch (c)
+            {
+            case '"':
+                sOut += "\\\"";
+                break;
+            case '\\':
+                sOut += "\\\\";
+                break;
+            case '\n':
+                sOut += "\\n";
+                break;
+            case '\r':
+                sOut += "\\r";
+                break;
+            case '\t':
+                sOut += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char szEscaped[8];
+                    snprintf(szEscaped, sizeof(szEscaped), "\\u%04x", static_cast<unsigned int>(static_cast<unsigned char>(c)));
+                    sOut += szEscaped;
+                }
+                else
+                {
+                    sOut += c;
+                }
+            }
+        }
+        sOut += '"';
+    } // appendJsonString()
+
+} // namespace
+
+
+thread_local pfl::MetricsRegistry::LocalShardCacheEntry pfl::MetricsRegistry::s_localShardCache[LocalShardCacheSize] = {};
+
+constexpr size_t pfl::MetricsRegistry::LocalShardCacheSize;
+
+
+// ############################### PUBLIC ################################
+
+
+uint64_t pfl::MetricsSnapshot::getCounter(const std::string& sName) const
+{
+    for (const auto& counter : counters)
+    {
+        if (counter.first == sName)
+        {
+            return counter.second;
+        }
+    }
+    return 0;
+} // getCounter()
+
+
+int64_t pfl::MetricsSnapshot::getGauge(const std::string& sName) const
+{
+    for (const auto& gauge : gauges)
+    {
+        if (gauge.first == sName)
+        {
+            return gauge.second;
+        }
+    }
+    return 0;
+} // getGauge()
+
+
+/**
+    @return One "name value" line per metric, counters first.
+*/
+std::string pfl::MetricsSnapshot::toText() const
+{
+    std::string sOut;
+    for (const auto& counter : counters)
+    {
+        sOut += counter.first;
+        sOut += ' ';
+        sOut += std::to_string(counter.second);
+        sOut += '\n';
+    }
+    for (const auto& gauge : gauges)
+    {
+        sOut += gauge.first;
+        sOut += ' ';
+        sOut += std::to_string(gauge.second);
+        sOut += '\n';
+    }
+    return sOut;
+} // toText()
+
+
+/**
+    @return JSON object in the form {"counters":{"name":value,...},"gauges":{"name":value,...}}.
+*/
+std::string pfl::MetricsSnapshot::toJson() const
+{
+    std::string sOut = "{\"counters\":{";
+    for (size_t i = 0; i < counters.size(); i++)
+    {
+        if (i > 0)
+        {
+            sOut += ',';
+        }
+        appendJsonString(sOut, counters[i].first);
+        sOut += ':';
+        sOut += std::to_string(counters[i].second);
+    }
+    sOut += "},\"gauges\":{";
+    for (size_t i = 0; i < gauges.size(); i++)
+    {
+        if (i > 0)
+        {
+            sOut += ',';
+        }
+        appendJsonString(sOut, gauges[i].first);
+        sOut += ':';
+        sOut += std::to_string(gauges[i].second);
+    }
+    sOut += "}}";
+    return sOut;
+} // toJson()
+
+
+/**
+    @param nMaxCounters Max number of counters. Each thread incrementing any counter allocates 8 bytes for each.
+                        Must be positive.
+                        Exception is thrown for zero value.
+    @param nMaxGauges   Max number of gauges.
+*/
+pfl::MetricsRegistry::MetricsRegistry(size_t nMaxCounters, size_t nMaxGauges) :
+    m_nId(nNextRegistryId.fetch_add(1, std::memory_order_relaxed)),
+    m_nMaxCounters(nMaxCounters),
+    m_nMaxGauges(nMaxGauges)
+{
+    if (!nMaxCounters)
+    {
+        throw std::runtime_error("Max number of counters must be positive!");
+    }
+
+    m_gauges.reset(new std::atomic<int64_t>[nMaxGauges]);
+    for (size_t i = 0; i < nMaxGauges; i++)
+    {
+        m_gauges[i].store(0, std::memory_order_relaxed);
+    }
+} // MetricsRegistry()
+
+
+/**
+    Gets the counter with the given name, registering it with zero value if not yet registered.
+    Thread-safe, but takes a lock, so keep the returned handle instead of calling this on the hot path.
+    Exception is thrown if the name is already used by a gauge, if its hash collides with the hash of another name, or if the
+    max number of counters is reached.
+*/
+pfl::Counter pfl::MetricsRegistry::counter(const std::string& sName)
+{
+    return Counter(this, registerName(sName, false));
+} // counter()
+
+
+/**
+    Gets the gauge with the given name, registering it with zero value if not yet registered.
+    Thread-safe, but takes a lock, so keep the returned handle instead of calling this on the hot path.
+    Exception is thrown if the name is already used by a counter, if its hash collides with the hash of another name, or if the
+    max number of gauges is reached.
+*/
+pfl::Gauge pfl::MetricsRegistry::gauge(const std::string& sName)
+{
+    return Gauge(&m_gauges[registerName(sName, true)]);
+} // gauge()
+
+
+/**
+    Gets the current values of all metrics, summing counters over all shards.
+    Increments made concurrently might or might not be included.
+*/
+pfl::MetricsSnapshot pfl::MetricsRegistry::snapshot() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    MetricsSnapshot snapshot;
+    snapshot.counters.reserve(m_counterNames.size());
+    for (size_t i = 0; i < m_counterNames.size(); i++)
+    {
+        uint64_t nSum = 0;
+        for (const auto& pShard : m_shards)
+        {
+            nSum += pShard->pCounters[i].load(std::memory_order_relaxed);
+        }
+        snapshot.counters.emplace_back(m_counterNames[i], nSum);
+    }
+
+    snapshot.gauges.reserve(m_gaugeNames.size());
+    for (size_t i = 0; i < m_gaugeNames.size(); i++)
+    {
+        snapshot.gauges.emplace_back(m_gaugeNames[i], m_gauges[i].load(std::memory_order_relaxed));
+    }
+    return snapshot;
+} // snapshot()
+
+
+size_t pfl::MetricsRegistry::numCounters() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_counterNames.size();
+} // numCounters()
+
+
+size_t pfl::MetricsRegistry::numGauges() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_gaugeNames.size();
+} // numGauges()
+
+
+size_t pfl::MetricsRegistry::numShards() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_shards.size();
+} // numShards()
+
+
+/**
+    Starts exporting: the first export happens after the given interval.
+
+    @param registry       The registry to be exported. Must outlive this exporter.
+    @param interval       Time between exports.
+    @param exportFunction Invoked with each snapshot, on the background thread of this exporter.
+*/
+pfl::MetricsExporter::MetricsExporter(const MetricsRegistry& registry, std::chrono::milliseconds interval, ExportFunction exportFunction) :
+    m_registry(registry),
+    m_interval(interval),
+    m_exportFunction(std::move(exportFunction))
+{
+    m_thread = std::thread(&MetricsExporter::run, this);
+} // MetricsExporter()
+
+
+pfl::MetricsExporter::~MetricsExporter()
+{
+    stop();
+} // ~MetricsExporter()
+
+
+/**
+    Stops the background thread, after a final export so the last values are not lost. Blocks until the thread has finished.
+    Does nothing if already stopped.
+*/
+void pfl::MetricsExporter::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStop = true;
+    }
+    m_cv.notify_one();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+} // stop()
+
+
+// ############################## PROTECTED ##############################
+
+
+// ############################### PRIVATE ###############################
+
+
+/**
+    Finds or creates the shard of the calling thread, and puts it into the thread-local cache.
+*/
+std::atomic<uint64_t>* pfl::MetricsRegistry::localCountersSlow()
+{
+    const std::thread::id threadId = std::this_thread::get_id();
+
+    std::atomic<uint64_t>* pCounters = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& pShard : m_shards)
+        {
+            if (pShard->threadId == threadId)
+            {
+                pCounters = pShard->pCounters;
+                break;
+            }
+        }
+
+        if (!pCounters)
+        {
+            std::unique_ptr<Shard> pShard(new Shard());
+            pShard->threadId = threadId;
+            pShard->counts.reset(new std::atomic<uint64_t>[m_nMaxCounters + 2 * nShardPadding]);
+            for (size_t i = 0; i < m_nMaxCounters + 2 * nShardPadding; i++)
+            {
+                pShard->counts[i].store(0, std::memory_order_relaxed);
+            }
+            pShard->pCounters = &pShard->counts[nShardPadding];
+            pCounters = pShard->pCounters;
+            m_shards.push_back(std::move(pShard));
+        }
+    }
+
+    // replace the oldest entry
+    for (size_t i = LocalShardCacheSize - 1; i > 0; i--)
+    {
+        s_localShardCache[i] = s_localShardCache[i - 1];
+    }
+    s_localShardCache[0].nRegistryId = m_nId;
+    s_localShardCache[0].pCounters = pCounters;
+    return pCounters;
+} // localCountersSlow()
+
+
+/**
+    @return Index of the counter or gauge with the given name, registered if needed.
+*/
+size_t pfl::MetricsRegistry::registerName(const std::string& sName, bool bGauge)
+{
+    const PFL::StringHash hash = PFL::calcHash(sName);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_names.find(hash);
+    if (it != m_names.end())
+    {
+        const std::vector<std::string>& names = it->second.first ? m_gaugeNames : m_counterNames;
+        if (names[it->second.second] != sName)
+        {
+            throw std::runtime_error("Metric name hash collision: " + sName + " vs. " + names[it->second.second] + "!");
+        }
+        if (it->second.first != bGauge)
+        {
+            throw std::runtime_error("Metric " + sName + " is already registered with different kind!");
+        }
+        return it->second.second;
+    }
+
+    std::vector<std::string>& names = bGauge ? m_gaugeNames : m_counterNames;
+    if (names.size() >= (bGauge ? m_nMaxGauges : m_nMaxCounters))
+    {
+        throw std::runtime_error(bGauge ? "Max number of gauges is reached!" : "Max number of counters is reached!");
+    }
+    names.push_back(sName);
+    m_names.emplace(hash, std::make_pair(bGauge, names.size() - 1));
+    return names.size() - 1;
+} // registerName()
+
+
+void pfl::MetricsExporter::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        const bool bStop = m_cv.wait_for(lock, m_interval, [this] { return m_bStop; });
+
+        lock.unlock();
+        m_exportFunction(m_registry.snapshot());
+        lock.lock();
+
+        if (bStop)
+        {
+            return;
+        }
+    }
+} // run()
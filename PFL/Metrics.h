@@ -0,0 +1,249 @@
+#pragma once
+
+/*
+    ###################################################################################
+    Metrics.h
+    Registry of named counters and gauges with per-thread sharded counters and periodic snapshot export.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "PFL.h"
+
+namespace pfl
+{
+    class MetricsRegistry;
+
+    /**
+    * Point-in-time values of all metrics of a MetricsRegistry, in order of registration.
+    */
+    struct MetricsSnapshot
+    {
+        std::vector<std::pair<std::string, uint64_t>> counters;
+        std::vector<std::pair<std::string, int64_t>> gauges;
+
+        uint64_t getCounter(const std::string& sName) const;  /**< Gets the value of the given counter, 0 if not found. */
+        int64_t getGauge(const std::string& sName) const;     /**< Gets the value of the given gauge, 0 if not found. */
+
+        std::string toText() const;  /**< Formats as "name value" lines. */
+        std::string toJson() const;  /**< Formats as a JSON object with "counters" and "gauges" objects. */
+    };
+
+    /**
+    * Handle of a counter registered in a MetricsRegistry. Cheap to copy.
+    * Incrementing only touches the shard of the calling thread: a relaxed load and store of its own counter, which is a plain
+    * non-atomic add on x86, without any lock prefix or cache line shared with other threads.
+    */
+    class Counter
+    {
+
+    public:
+
+        Counter() = default;
+
+        void add(uint64_t nValue = 1) const;  /**< Adds the given value to the counter. Thread-safe. */
+
+        bool isValid() const
+        {
+            return m_pRegistry != nullptr;
+        }
+
+    private:
+        friend class MetricsRegistry;
+
+        MetricsRegistry* m_pRegistry = nullptr;
+        size_t m_index = 0;
+
+        Counter(MetricsRegistry* pRegistry, size_t index) :
+            m_pRegistry(pRegistry),
+            m_index(index)
+        {}
+
+    }; // class Counter
+
+    /**
+    * Handle of a gauge registered in a MetricsRegistry. Cheap to copy.
+    * A gauge holds a current value, e.g. number of connected clients, so it is a single shared atomic, not sharded.
+    */
+    class Gauge
+    {
+
+    public:
+
+        Gauge() = default;
+
+        void set(int64_t nValue) const
+        {
+            m_pValue->store(nValue, std::memory_order_relaxed);
+        }
+
+        void add(int64_t nDelta) const
+        {
+            m_pValue->fetch_add(nDelta, std::memory_order_relaxed);
+        }
+
+        int64_t get() const
+        {
+            return m_pValue->load(std::memory_order_relaxed);
+        }
+
+        bool isValid() const
+        {
+            return m_pValue != nullptr;
+        }
+
+    private:
+        friend class MetricsRegistry;
+
+        std::atomic<int64_t>* m_pValue = nullptr;
+
+        explicit Gauge(std::atomic<int64_t>* pValue) :
+            m_pValue(pValue)
+        {}
+
+    }; // class Gauge
+
+    /**
+    * Registry of named counters and gauges.
+    *
+    * Names are interned by PFL::calcHash(). Getting a metric by name is meant to be done once, at initialization, keeping the
+    * returned handle for the hot path.
+    *
+    * Each thread incrementing any counter gets its own shard holding all counters, padded to avoid false sharing with other shards.
+    * Shards are summed only when a snapshot is taken. Shards are never freed before the registry, so values counted by exited threads
+    * are kept; a shard is reused by a later thread getting the same thread id.
+    *
+    * The max number of metrics is fixed in constructor, since shards are written without locking and thus cannot be reallocated.
+    * The registry must outlive all handles and all threads using them.
+    */
+    class MetricsRegistry
+    {
+
+    public:
+
+        MetricsRegistry(size_t nMaxCounters = 1024, size_t nMaxGauges = 256);
+        ~MetricsRegistry() = default;
+
+        MetricsRegistry(const MetricsRegistry&) = delete;
+        MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+        MetricsRegistry(MetricsRegistry&&) = delete;
+        MetricsRegistry& operator=(MetricsRegistry&&) = delete;
+
+        Counter counter(const std::string& sName);  /**< Gets the counter with the given name, registering it if needed. */
+        Gauge gauge(const std::string& sName);      /**< Gets the gauge with the given name, registering it if needed. */
+
+        MetricsSnapshot snapshot() const;           /**< Gets the current values of all metrics. */
+
+        size_t numCounters() const;
+        size_t numGauges() const;
+        size_t numShards() const;                   /**< Gets the number of threads having incremented any counter. */
+
+    private:
+        friend class Counter;
+
+        struct Shard
+        {
+            std::thread::id threadId;
+            std::unique_ptr<std::atomic<uint64_t>[]> counts;  /**< Counters, with padding of a cache line on both ends. */
+            std::atomic<uint64_t>* pCounters;                 /**< First counter, after the padding. */
+        };
+
+        struct LocalShardCacheEntry
+        {
+            uint64_t nRegistryId;
+            std::atomic<uint64_t>* pCounters;
+        };
+
+        static constexpr size_t LocalShardCacheSize = 4;
+
+        /** Shards of the current thread in the most recently used registries. Keyed by registry id, not by address, which could be reused. */
+        static thread_local LocalShardCacheEntry s_localShardCache[LocalShardCacheSize];
+
+        const uint64_t m_nId;
+        const size_t m_nMaxCounters;
+        const size_t m_nMaxGauges;
+        mutable std::mutex m_mutex;  /**< Guards all members below, except the gauge values. */
+        std::unordered_map<PFL::StringHash, std::pair<bool, size_t>> m_names;  /**< Hash of name -> (is gauge, index). */
+        std::vector<std::string> m_counterNames;
+        std::vector<std::string> m_gaugeNames;
+        std::unique_ptr<std::atomic<int64_t>[]> m_gauges;
+        std::vector<std::unique_ptr<Shard>> m_shards;
+
+        /**
+        * @return Counters of the shard of the calling thread.
+        */
+        std::atomic<uint64_t>* localCounters()
+        {
+            for (size_t i = 0; i < LocalShardCacheSize; i++)
+            {
+                if (s_localShardCache[i].nRegistryId == m_nId)
+                {
+                    return s_localShardCache[i].pCounters;
+                }
+            }
+            return localCountersSlow();
+        }
+
+        std::atomic<uint64_t>* localCountersSlow();
+        size_t registerName(const std::string& sName, bool bGauge);
+
+    }; // class MetricsRegistry
+
+    inline void Counter::add(uint64_t nValue) const
+    {
+        // only this thread writes this counter, so no atomic read-modify-write is needed
+        std::atomic<uint64_t>& counter = m_pRegistry->localCounters()[m_index];
+        counter.store(counter.load(std::memory_order_relaxed) + nValue, std::memory_order_relaxed);
+    }
+
+    /**
+    * Takes a snapshot of a MetricsRegistry periodically on a background thread, and passes it to the given function,
+    * e.g. for writing it to a log file or sending it to a monitoring service.
+    */
+    class MetricsExporter
+    {
+
+    public:
+
+        typedef std::function<void(const MetricsSnapshot& snapshot)> ExportFunction;
+
+        MetricsExporter(const MetricsRegistry& registry, std::chrono::milliseconds interval, ExportFunction exportFunction);
+        ~MetricsExporter();
+
+        MetricsExporter(const MetricsExporter&) = delete;
+        MetricsExporter& operator=(const MetricsExporter&) = delete;
+        MetricsExporter(MetricsExporter&&) = delete;
+        MetricsExporter& operator=(MetricsExporter&&) = delete;
+
+        void stop();  /**< Stops exporting, after a final export. */
+
+    private:
+        const MetricsRegistry& m_registry;
+        const std::chrono::milliseconds m_interval;
+        ExportFunction m_exportFunction;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        bool m_bStop = false;
+        std::thread m_thread;
+
+        void run();
+
+    }; // class MetricsExporter
+
+} // namespace
@@ -0,0 +1,417 @@
+#pragma once
+
+/*
+    ###################################################################################
+    ObjectPool.h
+    Fixed-capacity typed object pool with chunked storage and intrusive free list, with optional per-thread caches.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pfl
+{
+    /**
+    * Fixed-capacity pool of objects of type T.
+    *
+    * Storage is allocated in chunks of contiguous slots, so objects have stable addresses and objects allocated after each other
+    * are usually close in memory. A free slot stores the link to the next free slot in itself, so allocate() and release()
+    * are O(1) without any bookkeeping memory.
+    * Chunks are allocated on demand until capacity is reached; call preallocate() during loading to avoid any heap allocation later.
+    * Chunks are freed only when the pool is destroyed.
+    *
+    * allocate() and release() are NOT thread-safe. For use from multiple threads, each thread shall have its own ThreadCache,
+    * which takes and returns slots in batches under a mutex. Direct allocate()/release() must not be used while any ThreadCache
+    * of the same pool is in use.
+    *
+    * The pool does not track which slots are in use, so objects not released before destroying the pool are not destructed.
+    */
+    template <typename T>
+    class ObjectPool
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported!");
+
+        union Slot
+        {
+            Slot* pNext;  /**< Next free slot, valid only while the slot is free. */
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        };
+
+    public:
+
+        /**
+        * Per-thread front end of an ObjectPool.
+        * Keeps a local free list so that most allocations and releases do not touch the pool, and exchanges slots with the pool
+        * in batches under the pool's mutex.
+        * Objects can be released into a different ThreadCache of the same pool than they were allocated from.
+        * All ThreadCache instances must be destroyed before their pool.
+        */
+        class ThreadCache
+        {
+
+        public:
+
+            /**
+            * @param pool       The pool to allocate from.
+            * @param nBatchSize Number of slots taken from or given back to the pool at once.
+            *                   Must be positive.
+            *                   Exception is thrown for zero value.
+            */
+            ThreadCache(ObjectPool& pool, const size_t& nBatchSize = 32) :
+                m_pool(pool),
+                m_nBatchSize(nBatchSize)
+            {
+                if (!nBatchSize)
+                {
+                    throw std::runtime_error("Batch size must be positive!");
+                }
+            }
+
+            ~ThreadCache()
+            {
+                if (m_pHead)
+                {
+                    m_pool.pushListLocked(m_pHead, m_nSize);
+                }
+            }
+
+            ThreadCache(const ThreadCache&) = delete;
+            ThreadCache& operator=(const ThreadCache&) = delete;
+            ThreadCache(ThreadCache&&) = delete;
+            ThreadCache& operator=(ThreadCache&&) = delete;
+
+            /**
+            * Same as ObjectPool::allocate(), but taking the slot from the local cache.
+            */
+            template <typename... Args>
+            T* allocate(Args&&... args)
+            {
+                if (!m_pHead)
+                {
+                    m_pHead = m_pool.popListLocked(m_nBatchSize, m_nSize);
+                    if (!m_pHead)
+                    {
+                        return nullptr;
+                    }
+                }
+
+                Slot* const pSlot = m_pHead;
+                m_pHead = pSlot->pNext;
+                m_nSize--;
+                return construct(pSlot, m_pHead, m_nSize, std::forward<Args>(args)...);
+            }
+
+            /**
+            * Same as ObjectPool::release(), but putting the slot into the local cache.
+            * If the cache holds too many free slots, a batch of them is given back to the pool.
+            */
+            void release(T* p)
+            {
+                if (!p)
+                {
+                    return;
+                }
+
+                p->~T();
+                Slot* const pSlot = reinterpret_cast<Slot*>(p);
+                pSlot->pNext = m_pHead;
+                m_pHead = pSlot;
+                m_nSize++;
+
+                if (m_nSize >= 2 * m_nBatchSize)
+                {
+                    // keep one batch locally, give back the rest
+                    Slot* pLast = m_pHead;
+                    for (size_t i = 1; i < m_nBatchSize; i++)
+                    {
+                        pLast = pLast->pNext;
+                    }
+                    Slot* const pGiveBack = pLast->pNext;
+                    pLast->pNext = nullptr;
+                    m_pool.pushListLocked(pGiveBack, m_nSize - m_nBatchSize);
+                    m_nSize = m_nBatchSize;
+                }
+            }
+
+            /**
+            * @return Number of free slots currently held by this cache.
+            */
+            size_t size() const
+            {
+                return m_nSize;
+            }
+
+        private:
+            ObjectPool& m_pool;
+            const size_t m_nBatchSize;
+            Slot* m_pHead = nullptr;
+            size_t m_nSize = 0;
+
+        }; // class ThreadCache
+
+        /**
+        * @param capacity      Maximum number of objects to be allocated from this pool at the same time.
+        *                      Must be positive.
+        *                      Exception is thrown for zero value.
+        * @param chunkCapacity Number of objects per chunk of storage. The last chunk might be smaller so that capacity is not exceeded.
+        *                      Must be positive.
+        *                      Exception is thrown for zero value.
+        */
+        ObjectPool(const size_t& capacity, const size_t& chunkCapacity = 256) :
+            m_nCapacity(capacity),
+            m_nChunkCapacity(chunkCapacity)
+        {
+            if (!capacity)
+            {
+                throw std::runtime_error("Capacity must be positive!");
+            }
+            if (!chunkCapacity)
+            {
+                throw std::runtime_error("Chunk capacity must be positive!");
+            }
+        }
+
+        ~ObjectPool() = default;
+
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+        ObjectPool(ObjectPool&&) = delete;
+        ObjectPool& operator=(ObjectPool&&) = delete;
+
+        /**
+        * Allocates all chunks up to capacity, so that later allocations never allocate heap memory.
+        */
+        void preallocate()
+        {
+            while (addChunk())
+            {
+            }
+        }
+
+        /**
+        * Allocates a slot and constructs an object in it.
+        * If the constructor throws, the slot is put back to the pool and the exception is propagated.
+        * Complexity: O(1) constant, plus a chunk allocation if no free slot is left in the existing chunks.
+        *
+        * @return Pointer to the new object, or nullptr if the pool is full.
+        */
+        template <typename... Args>
+        T* allocate(Args&&... args)
+        {
+            if (!m_pFreeHead && !addChunk())
+            {
+                return nullptr;
+            }
+
+            Slot* const pSlot = m_pFreeHead;
+            m_pFreeHead = pSlot->pNext;
+            m_nFree--;
+            updatePeak();
+            return construct(pSlot, m_pFreeHead, m_nFree, std::forward<Args>(args)...);
+        }
+
+        /**
+        * Destructs the given object and gives its slot back to the pool.
+        * Complexity: O(1) constant.
+        *
+        * @param p An object allocated from this pool and not yet released. nullptr is ignored.
+        */
+        void release(T* p)
+        {
+            if (!p)
+            {
+                return;
+            }
+
+            assert(owns(p));
+            p->~T();
+            Slot* const pSlot = reinterpret_cast<Slot*>(p);
+            pSlot->pNext = m_pFreeHead;
+            m_pFreeHead = pSlot;
+            m_nFree++;
+        }
+
+        /**
+        * Tells if the given pointer points to a slot of this pool.
+        * Complexity: O(n) linear in the number of chunks. Meant for debug checks.
+        */
+        bool owns(const T* p) const
+        {
+            const Slot* const pSlot = reinterpret_cast<const Slot*>(p);
+            size_t nRemaining = m_nCapacity;
+            for (const auto& chunk : m_chunks)
+            {
+                const size_t nChunkSize = (nRemaining < m_nChunkCapacity) ? nRemaining : m_nChunkCapacity;
+                if ((pSlot >= chunk.get()) && (pSlot < chunk.get() + nChunkSize))
+                {
+                    return ((reinterpret_cast<const char*>(pSlot) - reinterpret_cast<const char*>(chunk.get())) % sizeof(Slot)) == 0;
+                }
+                nRemaining -= nChunkSize;
+            }
+            return false;
+        }
+
+        /**
+        * @return Maximum number of objects in the pool.
+        */
+        const size_t& capacity() const
+        {
+            return m_nCapacity;
+        }
+
+        /**
+        * @return Number of slots in use. Free slots held by ThreadCache instances are also counted here.
+        */
+        size_t size() const
+        {
+            return m_nAllocated - m_nFree;
+        }
+
+        /**
+        * @return Highest value of size() so far.
+        */
+        size_t peak() const
+        {
+            return m_nPeak;
+        }
+
+        /**
+        * @return Number of chunks allocated so far.
+        */
+        size_t numChunks() const
+        {
+            return m_chunks.size();
+        }
+
+        /**
+        * @return Number of slots in allocated chunks, i.e. the number of objects storable without allocating another chunk.
+        */
+        size_t numAllocatedSlots() const
+        {
+            return m_nAllocated;
+        }
+
+    private:
+        std::vector<std::unique_ptr<Slot[]>> m_chunks;
+        const size_t m_nCapacity;
+        const size_t m_nChunkCapacity;
+        size_t m_nAllocated = 0;      /**< Total number of slots in m_chunks. */
+        Slot* m_pFreeHead = nullptr;
+        size_t m_nFree = 0;           /**< Number of slots in the free list. */
+        size_t m_nPeak = 0;
+        std::mutex m_mutex;           /**< Used only by ThreadCache. */
+
+        /**
+        * Constructs a T in the given slot just removed from the given free list.
+        * If construction fails, the slot is put back to the head of the free list.
+        */
+        template <typename... Args>
+        static T* construct(Slot* pSlot, Slot*& pHead, size_t& nFree, Args&&... args)
+        {
+            try
+            {
+                return new (&pSlot->storage) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                pSlot->pNext = pHead;
+                pHead = pSlot;
+                nFree++;
+                throw;
+            }
+        }
+
+        /**
+        * Allocates the next chunk and puts all its slots to the free list.
+        * @return False if capacity is already reached, true otherwise.
+        */
+        bool addChunk()
+        {
+            const size_t nChunkSize = (m_nCapacity - m_nAllocated < m_nChunkCapacity) ? (m_nCapacity - m_nAllocated) : m_nChunkCapacity;
+            if (nChunkSize == 0)
+            {
+                return false;
+            }
+
+            std::unique_ptr<Slot[]> chunk(new Slot[nChunkSize]);
+            // link in address order, so consecutive allocations get consecutive addresses
+            for (size_t i = 0; i + 1 < nChunkSize; i++)
+            {
+                chunk[i].pNext = &chunk[i + 1];
+            }
+            chunk[nChunkSize - 1].pNext = m_pFreeHead;
+            m_pFreeHead = &chunk[0];
+            m_chunks.push_back(std::move(chunk));
+            m_nAllocated += nChunkSize;
+            m_nFree += nChunkSize;
+            return true;
+        }
+
+        void updatePeak()
+        {
+            if (size() > m_nPeak)
+            {
+                m_nPeak = size();
+            }
+        }
+
+        /**
+        * Takes at most nMax slots from the free list under the mutex.
+        * @return Head of the taken null-terminated list, or nullptr if the pool is full.
+        */
+        Slot* popListLocked(size_t nMax, size_t& nTaken)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_pFreeHead && !addChunk())
+            {
+                nTaken = 0;
+                return nullptr;
+            }
+
+            Slot* const pHead = m_pFreeHead;
+            Slot* pLast = pHead;
+            nTaken = 1;
+            while ((nTaken < nMax) && pLast->pNext)
+            {
+                pLast = pLast->pNext;
+                nTaken++;
+            }
+            m_pFreeHead = pLast->pNext;
+            pLast->pNext = nullptr;
+            m_nFree -= nTaken;
+            updatePeak();
+            return pHead;
+        }
+
+        /**
+        * Puts the given null-terminated list of n slots back to the free list under the mutex.
+        */
+        void pushListLocked(Slot* pHead, size_t n)
+        {
+            Slot* pLast = pHead;
+            while (pLast->pNext)
+            {
+                pLast = pLast->pNext;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            pLast->pNext = m_pFreeHead;
+            m_pFreeHead = pHead;
+            m_nFree += n;
+        }
+
+    }; // class ObjectPool
+
+} // namespace
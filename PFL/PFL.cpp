@@ -21,6 +21,15 @@
 #include <ctime> 
 #include <math.h>
 #include <random>  // cpp11
+#include <cstring>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define PFL_CRC32C_SSE42
+#include <nmmintrin.h>  // SSE4.2 crc32 intrinsics, used only if the CPU supports them
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
 
 // these includes below are needed only for the gettimeofday() implementation 
 #include "winproof88.h"
@@ -29,6 +38,124 @@
 #define M_PI
 
 
+namespace
+{
+    /**
+        Lookup tables for slicing-by-8 software CRC-32C, reflected Castagnoli polynomial 0x82F63B78.
+    */
+    struct Crc32cTables
+    {
+        uint32_t table[8][256];
+
+        Crc32cTables()
+        {
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t crc = i;
+                for (int j = 0; j < 8; j++)
+                {
+                    crc = (crc >> 1) ^ ((crc & 1u) ? 0x82F63B78u : 0u);
+                }
+                table[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                for (int k = 1; k < 8; k++)
+                {
+                    table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+                }
+            }
+        }
+    };
+
+    /**
+        Portable CRC-32C, processing 8 bytes per step. Assumes little-endian byte order.
+    */
+    uint32_t crc32cSoftware(uint32_t crc, const unsigned char* p, size_t n)
+    {
+        static const Crc32cTables tables;
+        const auto& t = tables.table;
+
+        while (n && (reinterpret_cast<uintptr_t>(p) & 7u))
+        {
+            crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+            n--;
+        }
+        while (n >= 8)
+        {
+            uint32_t lo;
+            uint32_t hi;
+            memcpy(&lo, p, sizeof(lo));
+            memcpy(&hi, p + 4, sizeof(hi));
+            lo ^= crc;
+            crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+            p += 8;
+            n -= 8;
+        }
+        while (n--)
+        {
+            crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+        }
+        return crc;
+    }
+
+#ifdef PFL_CRC32C_SSE42
+    /**
+        CRC-32C using the SSE4.2 crc32 instruction, 8 bytes per instruction on x64.
+    */
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((target("sse4.2")))
+#endif
+    uint32_t crc32cSse42(uint32_t crc, const unsigned char* p, size_t n)
+    {
+        while (n && (reinterpret_cast<uintptr_t>(p) & 7u))
+        {
+            crc = _mm_crc32_u8(crc, *p++);
+            n--;
+        }
+#if defined(_M_X64) || defined(__x86_64__)
+        uint64_t crc64 = crc;
+        while (n >= 8)
+        {
+            uint64_t v;
+            memcpy(&v, p, sizeof(v));
+            crc64 = _mm_crc32_u64(crc64, v);
+            p += 8;
+            n -= 8;
+        }
+        crc = static_cast<uint32_t>(crc64);
+#endif
+        while (n >= 4)
+        {
+            uint32_t v;
+            memcpy(&v, p, sizeof(v));
+            crc = _mm_crc32_u32(crc, v);
+            p += 4;
+            n -= 4;
+        }
+        while (n--)
+        {
+            crc = _mm_crc32_u8(crc, *p++);
+        }
+        return crc;
+    }
+
+    bool isSse42Supported()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 20)) != 0;
+#else
+        return __builtin_cpu_supports("sse4.2") != 0;
+#endif
+    }
+#endif // PFL_CRC32C_SSE42
+
+} // namespace
+
+
 // ############################### PUBLIC ################################
 
 
@@ -394,6 +521,27 @@ PFL::StringHash PFL::calcHash(const std::string& str)
 }
 
 
+/**
+    Calculates CRC-32C (Castagnoli) checksum of the given data, as used by iSCSI, ext4 and many file formats.
+    Uses the SSE4.2 crc32 instruction if the CPU supports it, otherwise a table-driven software implementation.
+    Both give the same result.
+
+    @param nCrc Checksum of previous data, to calculate the checksum of data given in multiple pieces. Zero for the first piece.
+
+    @return Checksum of the given data, following the previous data if nCrc is specified.
+*/
+uint32_t PFL::calcCrc32c(const void* pData, size_t nSize, uint32_t nCrc)
+{
+    typedef uint32_t (*Crc32cFunc)(uint32_t, const unsigned char*, size_t);
+#ifdef PFL_CRC32C_SSE42
+    static const Crc32cFunc pfnCrc32c = isSse42Supported() ? crc32cSse42 : crc32cSoftware;
+#else
+    static const Crc32cFunc pfnCrc32c = crc32cSoftware;
+#endif
+    return ~pfnCrc32c(~nCrc, static_cast<const unsigned char*>(pData), nSize);
+} // calcCrc32c()
+
+
 /**
     Returns PI.
 */
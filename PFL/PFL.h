@@ -36,6 +36,80 @@ namespace std
     }
 }
 
+namespace pfl
+{
+    namespace detail
+    {
+        // upcast: weak_ptr converting constructor, the strong count is not touched
+        template<class T, class U>
+        std::weak_ptr<T> weak_static_pointer_cast(std::weak_ptr<U> const& r, std::true_type) noexcept
+        {
+            return r;
+        }
+
+        // downcast: the object must be locked as weak_ptr has no aliasing constructor
+        template<class T, class U>
+        std::weak_ptr<T> weak_static_pointer_cast(std::weak_ptr<U> const& r, std::false_type) noexcept
+        {
+            std::shared_ptr<U> locked = r.lock();
+            if (!locked)
+            {
+                return std::weak_ptr<T>();
+            }
+#if __cplusplus >= 202002L
+            return std::static_pointer_cast<T>(std::move(locked));
+#else
+            return std::shared_ptr<T>(locked, static_cast<T*>(locked.get()));
+#endif
+        }
+
+        template<class T, class U>
+        std::weak_ptr<T> weak_dynamic_pointer_cast(std::weak_ptr<U> const& r, std::true_type) noexcept
+        {
+            return r;
+        }
+
+        template<class T, class U>
+        std::weak_ptr<T> weak_dynamic_pointer_cast(std::weak_ptr<U> const& r, std::false_type) noexcept
+        {
+            std::shared_ptr<U> locked = r.lock();
+            T* const p = dynamic_cast<T*>(locked.get());
+            if (!p)
+            {
+                return std::weak_ptr<T>();
+            }
+#if __cplusplus >= 202002L
+            return std::shared_ptr<T>(std::move(locked), p);
+#else
+            return std::shared_ptr<T>(locked, p);
+#endif
+        }
+    } // namespace detail
+
+    /**
+    * Non-throwing variant of std::static_pointer_cast for weak_ptr above.
+    * Returns an expired weak_ptr if r is expired, instead of throwing std::bad_weak_ptr.
+    * Upcasts do not touch the strong reference count at all. Downcasts lock r for the duration of the cast, using the
+    * aliasing constructor of shared_ptr, as the stored pointer of a weak_ptr cannot be accessed without locking.
+    */
+    template<class T, class U>
+    std::weak_ptr<T> weak_static_pointer_cast(std::weak_ptr<U> const& r) noexcept
+    {
+        return detail::weak_static_pointer_cast<T>(r, std::is_convertible<U*, T*>());
+    }
+
+    /**
+    * Non-throwing variant of std::dynamic_pointer_cast for weak_ptr above.
+    * Returns an expired weak_ptr if r is expired or the pointed object is not a T.
+    * Upcasts do not touch the strong reference count at all, and they are not checked at runtime.
+    */
+    template<class T, class U>
+    std::weak_ptr<T> weak_dynamic_pointer_cast(std::weak_ptr<U> const& r) noexcept
+    {
+        return detail::weak_dynamic_pointer_cast<T>(r, std::is_convertible<U*, T*>());
+    }
+} // namespace
+
 
 /**
     PR00F Foundation Library class.
@@ -106,6 +180,9 @@ public:
         char targetChar1 = ' ', char targetChar2 = '\t'); /**< Removes leading and trailing spaces and tabs from the given string. */
 
     static StringHash calcHash(const std::string& str);   /**< Calculates a hash for the given string. */
+    static uint32_t   calcCrc32c(
+        const void* pData, size_t nSize,
+        uint32_t nCrc = 0);                               /**< Calculates CRC-32C checksum of the given data. */
 
     static float pi();                          /**< Returns PI. */
 
@@ -0,0 +1,647 @@
+/*
+    ###################################################################################
+    PackedArchive.cpp
+    Read-only virtual file system over a single packed archive file, indexed by path hash.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include "PackedArchive.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "Path.h"
+
+
+namespace
+{
+    /**
+        On-disk header of the archive.
+    */
+    struct ArchiveHeader
+    {
+        char     magic[4];
+        uint32_t nVersion;
+        uint32_t nEntries;
+        uint32_t nReserved;
+        uint64_t nIndexOffset;
+    };
+
+    const char ArchiveMagic[4] = { 'P', 'F', 'L', 'A' };
+    const size_t DataAlignment = 16;
+
+    static_assert(sizeof(ArchiveHeader) == 24, "Archive header layout changed!");
+    static_assert(sizeof(pfl::PackedArchiveEntry) == 32, "Archive index entry layout changed!");
+
+    // LZ4 block format parameters, see https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+    const size_t MinMatch = 4;
+    const size_t LastLiterals = 5;    /**< Last 5 bytes are always literals. */
+    const size_t MatchFindLimit = 12; /**< Last match must start at least 12 bytes before end of block. */
+    const size_t MaxOffset = 65535;
+    const unsigned HashLog = 12;
+    const uint64_t MaxRatio = 255;    /**< A compressed byte decodes to at most 255 bytes (a length byte of 255). */
+
+    inline uint32_t read32(const char* p)
+    {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    void writeLength(std::vector<char>& out, size_t nLength)
+    {
+        while (nLength >= 255)
+        {
+            out.push_back(static_cast<char>(255));
+            nLength -= 255;
+        }
+        out.push_back(static_cast<char>(nLength));
+    }
+
+    void writeSequence(std::vector<char>& out, const char* pLiterals, size_t nLiterals, size_t nOffset, size_t nMatchLength)
+    {
+        const size_t nMatchCode = (nMatchLength >= MinMatch) ? (nMatchLength - MinMatch) : 0;
+        const unsigned char token = static_cast<unsigned char>(
+            ((std::min<size_t>(nLiterals, 15)) << 4) | (nMatchLength ? std::min<size_t>(nMatchCode, 15) : 0));
+        out.push_back(static_cast<char>(token));
+        if (nLiterals >= 15)
+        {
+            writeLength(out, nLiterals - 15);
+        }
+        out.insert(out.end(), pLiterals, pLiterals + nLiterals);
+
+        if (nMatchLength)
+        {
+            out.push_back(static_cast<char>(nOffset & 0xFF));
+            out.push_back(static_cast<char>((nOffset >> 8) & 0xFF));
+            if (nMatchCode >= 15)
+            {
+                writeLength(out, nMatchCode - 15);
+            }
+        }
+    }
+
+} // namespace
+
+
+// ############################### PUBLIC ################################
+
+
+pfl::PackedArchive::PackedArchive(PackedArchive&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+
+pfl::PackedArchive& pfl::PackedArchive::operator=(PackedArchive&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        // index points into the file content, so it is rebased on the moved content instead of relying on where that ends up
+        const size_t nIndexOffset = other.m_pIndex ? static_cast<size_t>(reinterpret_cast<const char*>(other.m_pIndex) - other.m_file.data()) : 0;
+        m_file = std::move(other.m_file);
+        m_pIndex = other.m_pIndex ? reinterpret_cast<const PackedArchiveEntry*>(m_file.data() + nIndexOffset) : nullptr;
+        m_nEntries = other.m_nEntries;
+
+        other.m_pIndex = nullptr;
+        other.m_nEntries = 0;
+    }
+    return *this;
+}
+
+
+/**
+    Opens the given archive file and validates its header and index.
+    Any previously opened archive is closed first.
+
+    @return True on success, false if the file cannot be opened or is not a valid archive.
+*/
+bool pfl::PackedArchive::open(const char* path)
+{
+    close();
+
+    // index is accessed randomly, data usually too
+    if (!m_file.open(path, false))
+    {
+        return false;
+    }
+
+    ArchiveHeader header;
+    if (m_file.size() < sizeof(header))
+    {
+        close();
+        return false;
+    }
+    memcpy(&header, m_file.data(), sizeof(header));
+
+    if ((memcmp(header.magic, ArchiveMagic, sizeof(ArchiveMagic)) != 0) ||
+        (header.nVersion != Version) ||
+        (header.nIndexOffset % alignof(PackedArchiveEntry) != 0) ||
+        (header.nIndexOffset > m_file.size()) ||
+        ((m_file.size() - header.nIndexOffset) / sizeof(PackedArchiveEntry) < header.nEntries))
+    {
+        close();
+        return false;
+    }
+
+    m_pIndex = reinterpret_cast<const PackedArchiveEntry*>(m_file.data() + header.nIndexOffset);
+    m_nEntries = header.nEntries;
+
+    for (size_t i = 0; i < m_nEntries; i++)
+    {
+        const PackedArchiveEntry& entry = m_pIndex[i];
+        // getData() and read() trust nSize: stored data of an uncompressed file is the content itself, and a compressed file
+        // cannot expand beyond the LZ4 ratio, so read() never allocates more than what the archive can actually decode to
+        const bool bCompressed = (entry.nFlags & PackedArchiveEntry::FlagCompressed) != 0;
+        if ((entry.nOffset > header.nIndexOffset) ||
+            (entry.nStoredSize > header.nIndexOffset - entry.nOffset) ||
+            (!bCompressed && (entry.nSize != entry.nStoredSize)) ||
+            (bCompressed && (entry.nSize > entry.nStoredSize * MaxRatio)) ||
+            (entry.nSize > std::numeric_limits<size_t>::max()) ||
+            ((i > 0) && (m_pIndex[i - 1].hash >= entry.hash)))
+        {
+            close();
+            return false;
+        }
+    }
+
+    return true;
+} // open()
+
+
+/**
+    Closes the archive.
+    Pointers returned by find() and getData() become invalid.
+*/
+void pfl::PackedArchive::close()
+{
+    m_file.close();
+    m_pIndex = nullptr;
+    m_nEntries = 0;
+} // close()
+
+
+/**
+    @return True if an archive is open, false otherwise.
+*/
+bool pfl::PackedArchive::isOpen() const
+{
+    return m_file.isOpen();
+} // isOpen()
+
+
+/**
+    @return Number of files in the archive.
+*/
+size_t pfl::PackedArchive::size() const
+{
+    return m_nEntries;
+} // size()
+
+
+/**
+    Finds the index entry of the given path.
+    See hashPath() about how paths are matched.
+
+    @return The found entry, or nullptr if the path is not in the archive.
+*/
+const pfl::PackedArchiveEntry* pfl::PackedArchive::find(const char* path) const
+{
+    return findByHash(hashPath(path));
+} // find()
+
+
+/**
+    Finds the index entry of the given path hash.
+    Interpolation search is used since hashes are evenly distributed, which needs only a few probes on average.
+    Falls back to binary search if interpolation does not converge fast, so worst case is still O(log N).
+
+    @return The found entry, or nullptr if the hash is not in the archive.
+*/
+const pfl::PackedArchiveEntry* pfl::PackedArchive::findByHash(PFL::StringHash hash) const
+{
+    if (m_nEntries == 0)
+    {
+        return nullptr;
+    }
+
+    size_t iLow = 0;
+    size_t iHigh = m_nEntries - 1;
+    for (int nProbes = 0; nProbes < 8; nProbes++)
+    {
+        const PFL::StringHash hashLow = m_pIndex[iLow].hash;
+        const PFL::StringHash hashHigh = m_pIndex[iHigh].hash;
+        if ((hash < hashLow) || (hash > hashHigh))
+        {
+            return nullptr;
+        }
+        if (hashLow == hashHigh)
+        {
+            return (hash == hashLow) ? &m_pIndex[iLow] : nullptr;
+        }
+
+        const size_t iProbe = iLow + static_cast<size_t>(
+            (static_cast<uint64_t>(hash - hashLow) * (iHigh - iLow)) / (hashHigh - hashLow));
+        if (m_pIndex[iProbe].hash == hash)
+        {
+            return &m_pIndex[iProbe];
+        }
+        if (m_pIndex[iProbe].hash < hash)
+        {
+            iLow = iProbe + 1;
+        }
+        else
+        {
+            if (iProbe == 0)
+            {
+                return nullptr;
+            }
+            iHigh = iProbe - 1;
+        }
+        if (iLow > iHigh)
+        {
+            return nullptr;
+        }
+    }
+
+    const PackedArchiveEntry* const pEnd = m_pIndex + iHigh + 1;
+    const PackedArchiveEntry* const pFound = std::lower_bound(
+        m_pIndex + iLow, pEnd, hash,
+        [](const PackedArchiveEntry& entry, PFL::StringHash value) { return entry.hash < value; });
+    return ((pFound != pEnd) && (pFound->hash == hash)) ? pFound : nullptr;
+} // findByHash()
+
+
+/**
+    Tells if the given path is in the archive.
+    Replacement for PFL::fileExists() for paths expected to be in the archive.
+
+    @return True if the given path is in the archive, false otherwise.
+*/
+bool pfl::PackedArchive::contains(const char* path) const
+{
+    return find(path) != nullptr;
+} // contains()
+
+
+/**
+    Gets the content of an uncompressed file without copying.
+
+    @param entry An entry returned by find() or findByHash().
+    @param pData Receives pointer to the content, valid until close().
+    @param nSize Receives size of the content.
+
+    @return True on success, false if the file is compressed, in which case read() shall be used.
+*/
+bool pfl::PackedArchive::getData(const PackedArchiveEntry& entry, const char*& pData, size_t& nSize) const
+{
+    if (entry.nFlags & PackedArchiveEntry::FlagCompressed)
+    {
+        return false;
+    }
+
+    pData = m_file.data() + entry.nOffset;
+    nSize = static_cast<size_t>(entry.nSize);
+    return true;
+} // getData()
+
+
+/**
+    Gets the content of a file, decompressing it if needed.
+
+    @param path Path of the file in the archive.
+    @param out  Receives the content. Its previous content is replaced.
+
+    @return True on success, false if the path is not in the archive or its data is corrupt.
+*/
+bool pfl::PackedArchive::read(const char* path, std::vector<char>& out) const
+{
+    const PackedArchiveEntry* const pEntry = find(path);
+    if (!pEntry)
+    {
+        return false;
+    }
+
+    const char* const pStored = m_file.data() + pEntry->nOffset;
+    out.resize(static_cast<size_t>(pEntry->nSize));
+    if (pEntry->nFlags & PackedArchiveEntry::FlagCompressed)
+    {
+        return PackedArchiveWriter::decompressBlock(pStored, static_cast<size_t>(pEntry->nStoredSize), out.data(), out.size());
+    }
+
+    if (!out.empty())
+    {
+        memcpy(out.data(), pStored, out.size());
+    }
+    return true;
+} // read()
+
+
+/**
+    Calculates the archive key of the given path.
+    The path is lexically normalized (see pfl::BasicPath::normalize()), then '\' is replaced by '/' and ASCII letters are lowercased,
+    so keys are the same regardless of platform and separator style.
+    Result is the same as PFL::calcHash() of the resulting string, but nothing is allocated for typical path lengths.
+*/
+PFL::StringHash pfl::PackedArchive::hashPath(const char* path)
+{
+    Path normalized(path);
+    normalized.normalize();
+
+    PFL::StringHash hash = 5381;
+    for (const char* p = normalized.c_str(); *p; p++)
+    {
+        char c = *p;
+        if (c == '\\')
+        {
+            c = '/';
+        }
+        else if ((c >= 'A') && (c <= 'Z'))
+        {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        hash = (hash << 5) + hash + static_cast<uint32_t>(c);
+    }
+    return hash;
+} // hashPath()
+
+
+/**
+    Adds the given content as a file to the archive.
+
+    @param archivePath Path of the file inside the archive, see PackedArchive::hashPath().
+    @param pData       The content.
+    @param nSize       Size of the content.
+    @param bCompress   If true, the content is stored compressed, unless compression does not make it smaller.
+
+    @return True on success, false if a file with the same hash (same path, or a colliding one) has already been added.
+*/
+bool pfl::PackedArchiveWriter::add(const char* archivePath, const char* pData, size_t nSize, bool bCompress)
+{
+    const PFL::StringHash hash = PackedArchive::hashPath(archivePath);
+    if (!m_hashes.insert(hash).second)
+    {
+        return false;
+    }
+
+    Pending pending;
+    pending.entry.hash = hash;
+    pending.entry.nFlags = 0;
+    pending.entry.nOffset = 0;
+    pending.entry.nSize = nSize;
+
+    if (bCompress && (nSize > 0))
+    {
+        compressBlock(pData, nSize, pending.data);
+        if (pending.data.size() < nSize)
+        {
+            pending.entry.nFlags |= PackedArchiveEntry::FlagCompressed;
+        }
+        else
+        {
+            pending.data.clear();
+        }
+    }
+    if (!(pending.entry.nFlags & PackedArchiveEntry::FlagCompressed))
+    {
+        pending.data.assign(pData, pData + nSize);
+    }
+    pending.entry.nStoredSize = pending.data.size();
+
+    m_entries.push_back(std::move(pending));
+    return true;
+} // add()
+
+
+/**
+    Adds the content of the given file to the archive.
+
+    @return True on success, false if the file cannot be read or add() fails.
+*/
+bool pfl::PackedArchiveWriter::addFile(const char* archivePath, const char* filePath, bool bCompress)
+{
+    MappedFile file;
+    if (!file.open(filePath))
+    {
+        return false;
+    }
+    return add(archivePath, file.data(), file.size(), bCompress);
+} // addFile()
+
+
+/**
+    Writes the archive file containing all files added so far.
+
+    @return True on success, false on I/O error.
+*/
+bool pfl::PackedArchiveWriter::write(const char* path) const
+{
+    std::vector<PackedArchiveEntry> index;
+    index.reserve(m_entries.size());
+
+    FILE* const f = fopen(path, "wb");
+    if (!f)
+    {
+        return false;
+    }
+
+    ArchiveHeader header;
+    memset(&header, 0, sizeof(header));
+    bool bOk = (fwrite(&header, sizeof(header), 1, f) == 1);
+
+    static const char padding[DataAlignment] = {};
+    uint64_t nPos = sizeof(header);
+    for (const auto& pending : m_entries)
+    {
+        const size_t nPad = static_cast<size_t>((DataAlignment - (nPos % DataAlignment)) % DataAlignment);
+        bOk = bOk && (fwrite(padding, 1, nPad, f) == nPad);
+        nPos += nPad;
+
+        index.push_back(pending.entry);
+        index.back().nOffset = nPos;
+
+        bOk = bOk && (pending.data.empty() || (fwrite(pending.data.data(), pending.data.size(), 1, f) == 1));
+        nPos += pending.data.size();
+    }
+
+    const size_t nPad = static_cast<size_t>((DataAlignment - (nPos % DataAlignment)) % DataAlignment);
+    bOk = bOk && (fwrite(padding, 1, nPad, f) == nPad);
+    nPos += nPad;
+
+    std::sort(index.begin(), index.end(),
+        [](const PackedArchiveEntry& a, const PackedArchiveEntry& b) { return a.hash < b.hash; });
+    bOk = bOk && (index.empty() || (fwrite(index.data(), sizeof(PackedArchiveEntry), index.size(), f) == index.size()));
+
+    memcpy(header.magic, ArchiveMagic, sizeof(ArchiveMagic));
+    header.nVersion = PackedArchive::Version;
+    header.nEntries = static_cast<uint32_t>(index.size());
+    header.nIndexOffset = nPos;
+    bOk = bOk && (fseek(f, 0, SEEK_SET) == 0) && (fwrite(&header, sizeof(header), 1, f) == 1);
+
+    bOk = (fclose(f) == 0) && bOk;
+    return bOk;
+} // write()
+
+
+/**
+    Compresses the given data in LZ4 block format, with a fast greedy single-hash-table matcher.
+    Output can be decompressed by decompressBlock() or by any LZ4 block decoder.
+
+    @param pSrc     Data to be compressed.
+    @param nSrcSize Size of data to be compressed.
+    @param out      Compressed data is appended to this buffer.
+
+    @return Number of bytes appended to out.
+*/
+size_t pfl::PackedArchiveWriter::compressBlock(const char* pSrc, size_t nSrcSize, std::vector<char>& out)
+{
+    const size_t nOutBegin = out.size();
+    out.reserve(nOutBegin + nSrcSize + nSrcSize / 255 + 16);
+
+    std::vector<uint32_t> table(static_cast<size_t>(1) << HashLog, 0u);
+    const char* const pEnd = pSrc + nSrcSize;
+    const char* pAnchor = pSrc;
+    const char* p = pSrc;
+
+    if (nSrcSize >= MatchFindLimit)
+    {
+        const char* const pMatchLimit = pEnd - MatchFindLimit;
+        const char* const pMatchEndLimit = pEnd - LastLiterals;
+        while (p <= pMatchLimit)
+        {
+            const uint32_t nSeq = read32(p);
+            const uint32_t h = (nSeq * 2654435761u) >> (32 - HashLog);
+            const char* const pRef = pSrc + table[h];
+            table[h] = static_cast<uint32_t>(p - pSrc);
+
+            if ((pRef >= p) || (static_cast<size_t>(p - pRef) > MaxOffset) || (read32(pRef) != nSeq))
+            {
+                p++;
+                continue;
+            }
+
+            size_t nMatchLength = MinMatch;
+            while ((p + nMatchLength < pMatchEndLimit) && (pRef[nMatchLength] == p[nMatchLength]))
+            {
+                nMatchLength++;
+            }
+
+            writeSequence(out, pAnchor, static_cast<size_t>(p - pAnchor), static_cast<size_t>(p - pRef), nMatchLength);
+            p += nMatchLength;
+            pAnchor = p;
+        }
+    }
+
+    writeSequence(out, pAnchor, static_cast<size_t>(pEnd - pAnchor), 0, 0);
+    return out.size() - nOutBegin;
+} // compressBlock()
+
+
+/**
+    Decompresses LZ4 block format data.
+    All reads and writes are bounds-checked, so corrupt input cannot cause out-of-bounds access.
+
+    @param pSrc     Compressed data.
+    @param nSrcSize Size of compressed data.
+    @param pDst     Buffer for decompressed data.
+    @param nDstSize Original size of the data, must be exactly the size of the decompressed data.
+
+    @return True on success, false if the compressed data is corrupt or does not decompress to exactly nDstSize bytes.
+*/
+bool pfl::PackedArchiveWriter::decompressBlock(const char* pSrc, size_t nSrcSize, char* pDst, size_t nDstSize)
+{
+    const unsigned char* ip = reinterpret_cast<const unsigned char*>(pSrc);
+    const unsigned char* const ipEnd = ip + nSrcSize;
+    char* op = pDst;
+    char* const opEnd = pDst + nDstSize;
+
+    while (ip < ipEnd)
+    {
+        const unsigned token = *ip++;
+
+        size_t nLiterals = token >> 4;
+        if (nLiterals == 15)
+        {
+            unsigned char b;
+            do
+            {
+                if (ip >= ipEnd)
+                {
+                    return false;
+                }
+                b = *ip++;
+                nLiterals += b;
+            } while (b == 255);
+        }
+        if ((nLiterals > static_cast<size_t>(ipEnd - ip)) || (nLiterals > static_cast<size_t>(opEnd - op)))
+        {
+            return false;
+        }
+        if (nLiterals > 0)
+        {
+            memcpy(op, ip, nLiterals);
+        }
+        ip += nLiterals;
+        op += nLiterals;
+
+        if (ip == ipEnd)
+        {
+            // last sequence has literals only
+            break;
+        }
+
+        if (ipEnd - ip < 2)
+        {
+            return false;
+        }
+        const size_t nOffset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if ((nOffset == 0) || (nOffset > static_cast<size_t>(op - pDst)))
+        {
+            return false;
+        }
+
+        size_t nMatchLength = token & 15;
+        if (nMatchLength == 15)
+        {
+            unsigned char b;
+            do
+            {
+                if (ip >= ipEnd)
+                {
+                    return false;
+                }
+                b = *ip++;
+                nMatchLength += b;
+            } while (b == 255);
+        }
+        nMatchLength += MinMatch;
+        if (nMatchLength > static_cast<size_t>(opEnd - op))
+        {
+            return false;
+        }
+
+        // match can overlap with its own output (e.g. offset 1 repeats the last byte), so copy forward byte by byte
+        const char* pMatch = op - nOffset;
+        for (size_t i = 0; i < nMatchLength; i++)
+        {
+            op[i] = pMatch[i];
+        }
+        op += nMatchLength;
+    }
+
+    return op == opEnd;
+} // decompressBlock()
+
+
+// ############################## PROTECTED ##############################
+
+
+// ############################### PRIVATE ###############################
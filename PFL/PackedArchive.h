@@ -0,0 +1,144 @@
+#pragma once
+
+/*
+    ###################################################################################
+    PackedArchive.h
+    Read-only virtual file system over a single packed archive file, indexed by path hash.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "MappedFile.h"
+#include "PFL.h"
+
+namespace pfl
+{
+    /**
+    * Index record of a file stored in a PackedArchive.
+    * This is also the on-disk layout of the index, so it must not be changed without bumping PackedArchive::Version.
+    */
+    struct PackedArchiveEntry
+    {
+        static constexpr uint32_t FlagCompressed = 1u << 0;  /**< Stored data is LZ4-block compressed. */
+
+        PFL::StringHash hash;         /**< PackedArchive::hashPath() of the path of the file. */
+        uint32_t        nFlags;       /**< Combination of Flag... bits. */
+        uint64_t        nOffset;      /**< Offset of stored data from the beginning of the archive file. */
+        uint64_t        nStoredSize;  /**< Size of stored data, which is the compressed size if compressed. */
+        uint64_t        nSize;        /**< Original size of the file. */
+    };
+
+    /**
+    * Read-only virtual file system over a single archive file created by PackedArchiveWriter.
+    *
+    * The archive is memory-mapped, and its index is an array of PackedArchiveEntry sorted by path hash, so looking up a file is an
+    * interpolation search over the mapped index without any file system access. Uncompressed files can be accessed without any copy.
+    *
+    * Archive layout (little-endian): 24-byte header ("PFLA", version, entry count, reserved, index offset), then file data,
+    * each file aligned to 16 bytes, then the index.
+    *
+    * Paths are identified only by their 32-bit hash, names are not stored. PackedArchiveWriter refuses to add colliding paths,
+    * so a hash found in the archive always belongs to the path it was added with. A path never added can still have the same hash as
+    * an added one, so contains() must only be used for paths expected to be in the archive, e.g. for choosing between archive and loose files.
+    */
+    class PackedArchive
+    {
+
+    public:
+
+        static constexpr uint32_t Version = 1;
+
+        PackedArchive() = default;
+        ~PackedArchive() = default;
+
+        PackedArchive(const PackedArchive&) = delete;
+        PackedArchive& operator=(const PackedArchive&) = delete;
+        PackedArchive(PackedArchive&& other) noexcept;
+        PackedArchive& operator=(PackedArchive&& other) noexcept;
+
+        bool open(const char* path);                                      /**< Opens and validates the given archive file. */
+        void close();                                                     /**< Closes the archive. */
+        bool isOpen() const;                                              /**< Tells if an archive is open. */
+        size_t size() const;                                              /**< Gets the number of files in the archive. */
+
+        const PackedArchiveEntry* find(const char* path) const;           /**< Finds the index entry of the given path. */
+        const PackedArchiveEntry* findByHash(PFL::StringHash hash) const; /**< Finds the index entry of the given path hash. */
+        bool contains(const char* path) const;                            /**< Tells if the given path is in the archive. */
+
+        bool getData(
+            const PackedArchiveEntry& entry,
+            const char*& pData, size_t& nSize) const;                     /**< Gets the content of an uncompressed file without copying. */
+        bool read(const char* path, std::vector<char>& out) const;        /**< Gets the content of a file, decompressing if needed. */
+
+        static PFL::StringHash hashPath(const char* path);                /**< Calculates the archive key of the given path. */
+
+    private:
+        MappedFile m_file;
+        const PackedArchiveEntry* m_pIndex = nullptr;  /**< Points into m_file. */
+        size_t m_nEntries = 0;
+
+    }; // class PackedArchive
+
+    /**
+    * Creates archive files for PackedArchive.
+    * Meant for tools and build steps: all added content is kept in memory until write().
+    */
+    class PackedArchiveWriter
+    {
+
+    public:
+
+        PackedArchiveWriter() = default;
+        ~PackedArchiveWriter() = default;
+
+        PackedArchiveWriter(const PackedArchiveWriter&) = delete;
+        PackedArchiveWriter& operator=(const PackedArchiveWriter&) = delete;
+        PackedArchiveWriter(PackedArchiveWriter&&) = default;
+        PackedArchiveWriter& operator=(PackedArchiveWriter&&) = default;
+
+        bool add(
+            const char* archivePath,
+            const char* pData, size_t nSize,
+            bool bCompress);                     /**< Adds the given content as a file to the archive. */
+        bool addFile(
+            const char* archivePath,
+            const char* filePath,
+            bool bCompress);                     /**< Adds the content of the given file to the archive. */
+        bool write(const char* path) const;      /**< Writes the archive file. */
+
+        /**
+        * @return Number of files added so far.
+        */
+        size_t size() const
+        {
+            return m_entries.size();
+        }
+
+        static size_t compressBlock(
+            const char* pSrc, size_t nSrcSize,
+            std::vector<char>& out);             /**< Compresses the given data in LZ4 block format. */
+        static bool decompressBlock(
+            const char* pSrc, size_t nSrcSize,
+            char* pDst, size_t nDstSize);        /**< Decompresses LZ4 block format data of known original size. */
+
+    private:
+
+        struct Pending
+        {
+            PackedArchiveEntry entry;  /**< Offset is filled only by write(). */
+            std::vector<char> data;    /**< Stored data, compressed if entry says so. */
+        };
+
+        std::vector<Pending> m_entries;
+        std::unordered_set<PFL::StringHash> m_hashes;  /**< Hashes of m_entries, to refuse colliding paths without scanning. */
+
+    }; // class PackedArchiveWriter
+
+} // namespace
@@ -0,0 +1,456 @@
+#pragma once
+
+/*
+    ###################################################################################
+    Path.h
+    Path builder with inline storage, for building and normalizing paths without heap allocation.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+namespace pfl
+{
+    /**
+    * Path string with an inline buffer of N chars (including the terminating null char).
+    * Paths shorter than N never allocate, longer paths spill to the heap transparently.
+    *
+    * Both '/' and '\' are accepted as separators, like in PFL path functions.
+    * New separators inserted by join() and normalize() are the same as the first separator already in the path, or '/' if there is none.
+    * All operations are lexical, the file system is never accessed.
+    */
+    template <size_t N>
+    class BasicPath
+    {
+        static_assert(N >= 2, "Inline capacity must be at least 2!");
+
+    public:
+
+        BasicPath() :
+            m_pData(m_inline),
+            m_nLength(0),
+            m_nCapacity(N - 1)
+        {
+            m_inline[0] = '\0';
+        }
+
+        BasicPath(const char* path) :
+            BasicPath()
+        {
+            assign(path, strlen(path));
+        }
+
+        BasicPath(const char* path, size_t nLength) :
+            BasicPath()
+        {
+            assign(path, nLength);
+        }
+
+        ~BasicPath()
+        {
+            if (!isInline())
+            {
+                delete[] m_pData;
+            }
+        }
+
+        BasicPath(const BasicPath& other) :
+            BasicPath()
+        {
+            assign(other.m_pData, other.m_nLength);
+        }
+
+        BasicPath& operator=(const BasicPath& other)
+        {
+            if (this != &other)
+            {
+                assign(other.m_pData, other.m_nLength);
+            }
+            return *this;
+        }
+
+        BasicPath(BasicPath&& other) noexcept :
+            BasicPath()
+        {
+            *this = std::move(other);
+        }
+
+        BasicPath& operator=(BasicPath&& other) noexcept
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+
+            if (other.isInline())
+            {
+                // fits into our inline buffer for sure, no allocation here
+                if (!isInline())
+                {
+                    delete[] m_pData;
+                    m_pData = m_inline;
+                    m_nCapacity = N - 1;
+                }
+                memcpy(m_pData, other.m_pData, other.m_nLength + 1);
+                m_nLength = other.m_nLength;
+            }
+            else
+            {
+                if (!isInline())
+                {
+                    delete[] m_pData;
+                }
+                m_pData = other.m_pData;
+                m_nLength = other.m_nLength;
+                m_nCapacity = other.m_nCapacity;
+                other.m_pData = other.m_inline;
+                other.m_nCapacity = N - 1;
+            }
+            other.m_nLength = 0;
+            other.m_pData[0] = '\0';
+            return *this;
+        }
+
+        /**
+        * @return The path as null-terminated string.
+        */
+        const char* c_str() const
+        {
+            return m_pData;
+        }
+
+        /**
+        * @return Length of the path in chars, without the terminating null char.
+        */
+        size_t length() const
+        {
+            return m_nLength;
+        }
+
+        /**
+        * @return True if the path is empty, false otherwise.
+        */
+        bool empty() const
+        {
+            return m_nLength == 0;
+        }
+
+        /**
+        * @return True if the path is stored in the inline buffer, false if it has spilled to the heap.
+        */
+        bool isInline() const
+        {
+            return m_pData == m_inline;
+        }
+
+        /**
+        * Makes the path empty. Heap storage, if any, is kept for reuse.
+        */
+        void clear()
+        {
+            m_nLength = 0;
+            m_pData[0] = '\0';
+        }
+
+        /**
+        * Replaces the path with the given string.
+        */
+        BasicPath& assign(const char* str, size_t nLength)
+        {
+            clear();
+            return append(str, nLength);
+        }
+
+        /**
+        * Appends the given string to the path as it is, without inserting separator.
+        * Useful for adding a suffix to the filename.
+        */
+        BasicPath& append(const char* str, size_t nLength)
+        {
+            // str might point into our own buffer which reserve() might free
+            const bool bFromSelf = (str >= m_pData) && (str <= m_pData + m_nLength);
+            const size_t iFromSelf = bFromSelf ? static_cast<size_t>(str - m_pData) : 0;
+            reserve(m_nLength + nLength);
+            if (bFromSelf)
+            {
+                str = m_pData + iFromSelf;
+            }
+            memmove(m_pData + m_nLength, str, nLength);
+            m_nLength += nLength;
+            m_pData[m_nLength] = '\0';
+            return *this;
+        }
+
+        BasicPath& append(const char* str)
+        {
+            return append(str, strlen(str));
+        }
+
+        BasicPath& operator+=(const char* str)
+        {
+            return append(str, strlen(str));
+        }
+
+        /**
+        * Appends the given path component, inserting a separator if the path does not end with one and the component does not begin with one.
+        * Example: "Assets" joined with "Maps" is "Assets/Maps".
+        */
+        BasicPath& join(const char* component)
+        {
+            const size_t nCompLength = strlen(component);
+            // reserve once for both appends, so a component pointing into our own buffer stays valid
+            const bool bFromSelf = (component >= m_pData) && (component <= m_pData + m_nLength);
+            const size_t iFromSelf = bFromSelf ? static_cast<size_t>(component - m_pData) : 0;
+            reserve(m_nLength + 1 + nCompLength);
+            if (bFromSelf)
+            {
+                component = m_pData + iFromSelf;
+            }
+
+            if ((m_nLength > 0) && !isSeparator(m_pData[m_nLength - 1]) && ((nCompLength == 0) || !isSeparator(component[0])))
+            {
+                const char sep = separator();
+                append(&sep, 1);
+            }
+            return append(component, nCompLength);
+        }
+
+        /**
+        * @return The first separator char in the path, or '/' if there is none.
+        */
+        char separator() const
+        {
+            for (size_t i = 0; i < m_nLength; i++)
+            {
+                if (isSeparator(m_pData[i]))
+                {
+                    return m_pData[i];
+                }
+            }
+            return '/';
+        }
+
+        /**
+        * @return Length of the directory part of the path, including its trailing separator. 0 if the path has no directory part.
+        */
+        size_t directoryLength() const
+        {
+            for (size_t i = m_nLength; i > 0; i--)
+            {
+                if (isSeparator(m_pData[i - 1]) || ((i == 2) && (m_pData[1] == ':')))
+                {
+                    return i;
+                }
+            }
+            return 0;
+        }
+
+        /**
+        * @return The filename part of the path, i.e. everything after the last separator. Points into this path.
+        */
+        const char* filename() const
+        {
+            return m_pData + directoryLength();
+        }
+
+        /**
+        * @return The extension of the filename without the dot, or empty string if there is none. Points into this path.
+        *         A leading dot of the filename does not start an extension, so ".cfg" has no extension.
+        */
+        const char* extension() const
+        {
+            const size_t iExtDot = extensionDotIndex();
+            return (iExtDot == m_nLength) ? (m_pData + m_nLength) : (m_pData + iExtDot + 1);
+        }
+
+        /**
+        * Removes the filename part, keeping the directory part with its trailing separator.
+        */
+        BasicPath& removeFilename()
+        {
+            m_nLength = directoryLength();
+            m_pData[m_nLength] = '\0';
+            return *this;
+        }
+
+        /**
+        * Replaces the extension of the filename. Same as PFL::changeExtension() but works in place.
+        *
+        * @param ext The new extension, with or without leading dot. Empty string removes the extension including the dot.
+        */
+        BasicPath& replaceExtension(const char* ext)
+        {
+            m_nLength = extensionDotIndex();
+            m_pData[m_nLength] = '\0';
+            if (*ext == '.')
+            {
+                ext++;
+            }
+            if (*ext != '\0')
+            {
+                append(".", 1);
+                append(ext);
+            }
+            return *this;
+        }
+
+        /**
+        * Lexically normalizes the path in place:
+        * - separators are unified to separator(), and duplicate separators are collapsed (except a leading double separator of UNC paths);
+        * - "." segments are removed;
+        * - ".." segments remove the preceding segment, and are dropped directly after the root of an absolute path;
+        * - a trailing separator is kept.
+        * A path becoming empty this way is set to ".".
+        * Complexity: O(length), no allocation.
+        */
+        BasicPath& normalize()
+        {
+            if (m_nLength == 0)
+            {
+                return *this;
+            }
+
+            const char sep = separator();
+            const bool bTrailingSep = isSeparator(m_pData[m_nLength - 1]);
+            char* const p = m_pData;
+            size_t r = 0;  // read index
+            size_t w = 0;  // write index, never greater than r
+
+            if ((m_nLength >= 2) && (p[1] == ':'))
+            {
+                r = w = 2;
+            }
+
+            size_t nLeadingSeps = 0;
+            while ((r < m_nLength) && isSeparator(p[r]))
+            {
+                r++;
+                nLeadingSeps++;
+            }
+            const bool bAbsolute = (nLeadingSeps > 0);
+            if (bAbsolute)
+            {
+                p[w++] = sep;
+                if ((nLeadingSeps == 2) && (w == 1))
+                {
+                    p[w++] = sep;
+                }
+            }
+            const size_t iRootEnd = w;
+
+            while (r < m_nLength)
+            {
+                const size_t iSegment = r;
+                while ((r < m_nLength) && !isSeparator(p[r]))
+                {
+                    r++;
+                }
+                const size_t nSegment = r - iSegment;
+                while ((r < m_nLength) && isSeparator(p[r]))
+                {
+                    r++;
+                }
+
+                if ((nSegment == 1) && (p[iSegment] == '.'))
+                {
+                    continue;
+                }
+
+                if ((nSegment == 2) && (p[iSegment] == '.') && (p[iSegment + 1] == '.'))
+                {
+                    size_t iLastSegment = w;
+                    while ((iLastSegment > iRootEnd) && !isSeparator(p[iLastSegment - 1]))
+                    {
+                        iLastSegment--;
+                    }
+                    const bool bLastIsDotDot = (w - iLastSegment == 2) && (p[iLastSegment] == '.') && (p[iLastSegment + 1] == '.');
+                    if ((w > iRootEnd) && !bLastIsDotDot)
+                    {
+                        // drop the last segment together with its preceding separator
+                        w = (iLastSegment > iRootEnd) ? (iLastSegment - 1) : iRootEnd;
+                        continue;
+                    }
+                    if (bAbsolute)
+                    {
+                        // cannot go above root
+                        continue;
+                    }
+                }
+
+                if (w > iRootEnd)
+                {
+                    p[w++] = sep;
+                }
+                memmove(p + w, p + iSegment, nSegment);
+                w += nSegment;
+            }
+
+            if (bTrailingSep && (w > iRootEnd))
+            {
+                p[w++] = sep;
+            }
+            if (w == 0)
+            {
+                p[w++] = '.';
+            }
+
+            m_nLength = w;
+            m_pData[m_nLength] = '\0';
+            return *this;
+        }
+
+    private:
+        char   m_inline[N];   /**< Inline storage, used as long as the path fits. */
+        char*  m_pData;       /**< Either m_inline or a heap block. */
+        size_t m_nLength;     /**< Length without terminating null char. */
+        size_t m_nCapacity;   /**< Max length storable in m_pData, without terminating null char. */
+
+        static bool isSeparator(char c)
+        {
+            return (c == '/') || (c == '\\');
+        }
+
+        /**
+        * @return Index of the dot starting the extension, or length() if the filename has no extension.
+        */
+        size_t extensionDotIndex() const
+        {
+            const size_t iFilename = directoryLength();
+            for (size_t i = m_nLength; i > iFilename + 1; i--)
+            {
+                if (m_pData[i - 1] == '.')
+                {
+                    return i - 1;
+                }
+            }
+            return m_nLength;
+        }
+
+        void reserve(size_t nLength)
+        {
+            if (nLength <= m_nCapacity)
+            {
+                return;
+            }
+
+            const size_t nNewCapacity = (nLength > 2 * m_nCapacity) ? nLength : (2 * m_nCapacity);
+            char* const pNewData = new char[nNewCapacity + 1];
+            memcpy(pNewData, m_pData, m_nLength + 1);
+            if (!isInline())
+            {
+                delete[] m_pData;
+            }
+            m_pData = pNewData;
+            m_nCapacity = nNewCapacity;
+        }
+
+    }; // class BasicPath
+
+    typedef BasicPath<256> Path;  /**< Path type with inline capacity enough for most asset paths. */
+
+} // namespace
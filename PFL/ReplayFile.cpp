@@ -0,0 +1,602 @@
+/*
+    ###################################################################################
+    ReplayFile.cpp
+    Append-only chunked binary file format for recording and replaying per-tick data.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include "ReplayFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "PFL.h"
+
+
+namespace
+{
+    /**
+        On-disk header of the file.
+    */
+    struct FileHeader
+    {
+        char     magic[4];
+        uint32_t nVersion;
+        uint32_t nReserved[2];
+    };
+
+    /**
+        On-disk header of each chunk, followed by the data padded to ChunkAlignment.
+        The checksum covers the other fields of the header and the data.
+    */
+    struct ChunkHeader
+    {
+        uint32_t nType;
+        uint32_t nSize;
+        uint64_t nTick;
+        uint32_t nCrc;
+        uint32_t nReserved;
+    };
+
+    /**
+        On-disk index entry.
+    */
+    struct IndexRecord
+    {
+        uint64_t nTick;
+        uint64_t nOffset;
+    };
+
+    /**
+        Last bytes of a properly closed file, following the index.
+        The checksum covers the index and the fields of the footer before it.
+    */
+    struct Footer
+    {
+        uint64_t nIndexOffset;
+        uint64_t nChunks;
+        uint32_t nIndexCount;
+        uint32_t nCrc;
+        char     magic[4];
+        uint32_t nReserved;
+    };
+
+    const char FileMagic[4] = { 'P', 'F', 'L', 'R' };
+    const char FooterMagic[4] = { 'P', 'F', 'L', 'I' };
+    const size_t ChunkAlignment = 8;
+
+    static_assert(sizeof(FileHeader) == 16, "Replay file header layout changed!");
+    static_assert(sizeof(ChunkHeader) == 24, "Replay chunk header layout changed!");
+    static_assert(sizeof(IndexRecord) == 16, "Replay index layout changed!");
+    static_assert(sizeof(Footer) == 32, "Replay footer layout changed!");
+
+    inline uint64_t alignChunkSize(uint64_t nSize)
+    {
+        return (nSize + ChunkAlignment - 1) & ~static_cast<uint64_t>(ChunkAlignment - 1);
+    }
+
+    uint32_t calcChunkCrc(const ChunkHeader& header, const char* pData)
+    {
+        uint32_t nCrc = PFL::calcCrc32c(&header, offsetof(ChunkHeader, nCrc));
+        nCrc = PFL::calcCrc32c(&header.nReserved, sizeof(header.nReserved), nCrc);
+        return PFL::calcCrc32c(pData, header.nSize, nCrc);
+    }
+
+    uint32_t calcFooterCrc(const char* pIndex, size_t nIndexSize, const Footer& footer)
+    {
+        const uint32_t nCrc = PFL::calcCrc32c(pIndex, nIndexSize);
+        return PFL::calcCrc32c(&footer, offsetof(Footer, nCrc), nCrc);
+    }
+
+} // namespace
+
+
+constexpr uint32_t pfl::ReplayWriter::Version;
+constexpr size_t pfl::ReplayWriter::IndexInterval;
+
+
+// ############################### PUBLIC ################################
+
+
+pfl::ReplayWriter::~ReplayWriter()
+{
+    close();
+}
+
+
+/**
+    Creates the given file, overwriting any existing file, and starts the background writer thread.
+    Any previously opened file is closed first.
+
+    @param nBufferSize  Size of each buffer collecting chunks, the size of a single write to the file.
+                        Must be positive.
+                        Exception is thrown for zero value.
+    @param nBufferCount Max number of buffers. If all of them are full and waiting to be written, write() blocks until one
+                        is written, so chunks are never dropped.
+                        Must be at least 2.
+                        Exception is thrown for less value.
+
+    @return True on success, false if the file cannot be created.
+*/
+bool pfl::ReplayWriter::open(const char* path, size_t nBufferSize, size_t nBufferCount)
+{
+    close();
+
+    if (!nBufferSize)
+    {
+        throw std::runtime_error("Buffer size must be positive!");
+    }
+    if (nBufferCount < 2)
+    {
+        throw std::runtime_error("Buffer count must be at least 2!");
+    }
+
+    FILE* const pFile = fopen(path, "wb");
+    if (!pFile)
+    {
+        return false;
+    }
+
+    FileHeader header = {};
+    memcpy(header.magic, FileMagic, sizeof(FileMagic));
+    header.nVersion = Version;
+    if (fwrite(&header, sizeof(header), 1, pFile) != 1)
+    {
+        fclose(pFile);
+        return false;
+    }
+
+    m_pFile = pFile;
+    m_nBufferSize = nBufferSize;
+    m_nBufferCount = nBufferCount;
+    m_current.clear();
+    m_current.reserve(nBufferSize);
+    m_nBuffers = 1;
+    m_nFileSize = sizeof(FileHeader);
+    m_nChunks = 0;
+    m_nLastTick = 0;
+    m_nLastIndexedOffset = 0;
+    m_index.clear();
+    m_bWriting = false;
+    m_bStop = false;
+    m_bError = false;
+    m_thread = std::thread(&ReplayWriter::threadFunc, this);
+    return true;
+} // open()
+
+
+/**
+    Writes all pending chunks and the index, closes the file and stops the background writer thread.
+    After a write error, the index is not written either, so the file ends at the last successfully written chunk,
+    and ReplayReader recovers it like the file of a crashed recording.
+
+    @return True if the whole file has been written successfully, false otherwise or if no file is open.
+*/
+bool pfl::ReplayWriter::close()
+{
+    if (!m_pFile)
+    {
+        return false;
+    }
+
+    if (!m_current.empty())
+    {
+        submitCurrent();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStop = true;
+    }
+    m_cvWork.notify_one();
+    m_thread.join();
+
+    std::vector<IndexRecord> index(m_index.size());
+    for (size_t i = 0; i < m_index.size(); i++)
+    {
+        index[i].nTick = m_index[i].nTick;
+        index[i].nOffset = m_index[i].nOffset;
+    }
+
+    Footer footer = {};
+    footer.nIndexOffset = m_nFileSize;
+    footer.nChunks = m_nChunks;
+    footer.nIndexCount = static_cast<uint32_t>(index.size());
+    memcpy(footer.magic, FooterMagic, sizeof(FooterMagic));
+    footer.nCrc = calcFooterCrc(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(IndexRecord), footer);
+
+    // the thread has exited, so m_bError can be accessed without the lock;
+    // after a write error the index would point over a gap, so it is not written
+    bool bOk = !m_bError;
+    if (bOk && !index.empty())
+    {
+        bOk = (fwrite(index.data(), sizeof(IndexRecord), index.size(), m_pFile) == index.size());
+    }
+    bOk = bOk && (fwrite(&footer, sizeof(footer), 1, m_pFile) == 1);
+    bOk = (fclose(m_pFile) == 0) && bOk;
+
+    m_pFile = nullptr;
+    m_current = std::vector<char>();
+    m_queue.clear();
+    m_free.clear();
+    m_nBuffers = 0;
+    m_index.clear();
+    return bOk;
+} // close()
+
+
+/**
+    Blocks until all chunks written so far are written to the file and flushed from the C runtime buffers.
+    Useful before reading the file while still recording, e.g. for saving the last minutes of a session on a bug report.
+
+    @return True if everything has been written successfully so far, false otherwise or if no file is open.
+*/
+bool pfl::ReplayWriter::flush()
+{
+    if (!m_pFile)
+    {
+        return false;
+    }
+
+    if (!m_current.empty())
+    {
+        submitCurrent();
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cvDone.wait(lock, [this] { return m_queue.empty() && !m_bWriting; });
+    // the background thread is idle until we submit again, so the file can be used here
+    if (fflush(m_pFile) != 0)
+    {
+        m_bError = true;
+    }
+    return !m_bError;
+} // flush()
+
+
+/**
+    Appends a chunk. Copies the data into the current buffer, and hands the buffer over to the background thread when full.
+    Blocks only if all buffers are waiting to be written.
+    Must be invoked only by a single thread at a time.
+
+    @param nType User-defined type of the chunk.
+    @param nTick Tick the chunk belongs to. Must not be less than the tick of the previous chunk.
+
+    @return True on success, false if the tick is less than the tick of the previous chunk, the chunk is bigger than 4 GiB,
+            or the file is not open.
+*/
+bool pfl::ReplayWriter::write(uint32_t nType, uint64_t nTick, const void* pData, size_t nSize)
+{
+    if (!m_pFile || (m_nChunks && (nTick < m_nLastTick)) || (static_cast<uint64_t>(nSize) > UINT32_MAX))
+    {
+        return false;
+    }
+
+    const size_t nChunkSize = static_cast<size_t>(sizeof(ChunkHeader) + alignChunkSize(nSize));
+    if (!m_current.empty() && (m_current.size() + nChunkSize > m_nBufferSize))
+    {
+        submitCurrent();
+    }
+
+    if (!m_nChunks || (m_nFileSize - m_nLastIndexedOffset >= IndexInterval))
+    {
+        m_index.push_back(IndexEntry{ nTick, m_nFileSize });
+        m_nLastIndexedOffset = m_nFileSize;
+    }
+
+    // checksum is calculated by the background thread
+    ChunkHeader header = {};
+    header.nType = nType;
+    header.nSize = static_cast<uint32_t>(nSize);
+    header.nTick = nTick;
+    const char* const pHeader = reinterpret_cast<const char*>(&header);
+    const char* const pBytes = static_cast<const char*>(pData);
+    static const char padding[ChunkAlignment] = {};
+    m_current.insert(m_current.end(), pHeader, pHeader + sizeof(header));
+    m_current.insert(m_current.end(), pBytes, pBytes + nSize);
+    m_current.insert(m_current.end(), padding, padding + (nChunkSize - sizeof(header) - nSize));
+
+    m_nFileSize += nChunkSize;
+    m_nChunks++;
+    m_nLastTick = nTick;
+    return true;
+} // write()
+
+
+bool pfl::ReplayWriter::hasError() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bError;
+} // hasError()
+
+
+/**
+    Opens the given replay file, validates its header and loads its index.
+    If the file has no valid index, all chunks are scanned and verified, and reading is limited to the chunks before the first
+    incomplete or corrupt chunk.
+    Any previously opened file is closed first.
+
+    @return True on success, false if the file cannot be opened or is not a replay file of the supported version.
+*/
+bool pfl::ReplayReader::open(const char* path)
+{
+    close();
+
+    if (!m_file.open(path, true))
+    {
+        return false;
+    }
+
+    FileHeader header;
+    const uint64_t nFileSize = m_file.size();
+    if (nFileSize < sizeof(header))
+    {
+        close();
+        return false;
+    }
+    memcpy(&header, m_file.data(), sizeof(header));
+    if ((memcmp(header.magic, FileMagic, sizeof(FileMagic)) != 0) || (header.nVersion != ReplayWriter::Version))
+    {
+        close();
+        return false;
+    }
+
+    Footer footer;
+    bool bHasIndex = false;
+    if (nFileSize >= sizeof(FileHeader) + sizeof(Footer))
+    {
+        memcpy(&footer, m_file.data() + nFileSize - sizeof(Footer), sizeof(footer));
+        const uint64_t nIndexSize = static_cast<uint64_t>(footer.nIndexCount) * sizeof(IndexRecord);
+        bHasIndex =
+            (memcmp(footer.magic, FooterMagic, sizeof(FooterMagic)) == 0) &&
+            (footer.nIndexOffset >= sizeof(FileHeader)) &&
+            (footer.nIndexOffset <= nFileSize) &&
+            (nFileSize - footer.nIndexOffset == nIndexSize + sizeof(Footer)) &&
+            (footer.nCrc == calcFooterCrc(m_file.data() + footer.nIndexOffset, static_cast<size_t>(nIndexSize), footer));
+    }
+
+    if (bHasIndex)
+    {
+        m_index.resize(footer.nIndexCount);
+        if (footer.nIndexCount)
+        {
+            memcpy(m_index.data(), m_file.data() + footer.nIndexOffset, footer.nIndexCount * sizeof(IndexRecord));
+        }
+        m_nDataEnd = footer.nIndexOffset;
+        m_nChunks = footer.nChunks;
+        m_bRecovered = false;
+    }
+    else
+    {
+        // not properly closed, find the complete chunks and build the index the same way as the writer does
+        m_nDataEnd = nFileSize;
+        m_bRecovered = true;
+        uint64_t nOffset = sizeof(FileHeader);
+        uint64_t nLastIndexedOffset = 0;
+        ReplayChunk chunk;
+        uint64_t nNextOffset;
+        while (parseChunk(nOffset, chunk, nNextOffset, true))
+        {
+            if (!m_nChunks || (nOffset - nLastIndexedOffset >= ReplayWriter::IndexInterval))
+            {
+                m_index.push_back(IndexEntry{ chunk.nTick, nOffset });
+                nLastIndexedOffset = nOffset;
+            }
+            m_nChunks++;
+            nOffset = nNextOffset;
+        }
+        m_nDataEnd = nOffset;
+    }
+
+    m_nPos = sizeof(FileHeader);
+    m_bCorrupt = false;
+    return true;
+} // open()
+
+
+void pfl::ReplayReader::close()
+{
+    m_file.close();
+    m_index.clear();
+    m_nDataEnd = 0;
+    m_nPos = 0;
+    m_nChunks = 0;
+    m_bRecovered = false;
+    m_bCorrupt = false;
+} // close()
+
+
+/**
+    Reads the next chunk and verifies its checksum.
+
+    @param chunk Set to the next chunk. Its data points into the mapped file.
+
+    @return True if a chunk has been read, false at the end of the file, if the chunk is corrupt, or if no file is open.
+*/
+bool pfl::ReplayReader::next(ReplayChunk& chunk)
+{
+    if (m_bCorrupt || (m_nPos >= m_nDataEnd))
+    {
+        return false;
+    }
+
+    uint64_t nNextOffset;
+    if (!parseChunk(m_nPos, chunk, nNextOffset, true))
+    {
+        m_bCorrupt = true;
+        return false;
+    }
+    m_nPos = nNextOffset;
+    return true;
+} // next()
+
+
+void pfl::ReplayReader::rewind()
+{
+    if (isOpen())
+    {
+        m_nPos = sizeof(FileHeader);
+        m_bCorrupt = false;
+    }
+} // rewind()
+
+
+/**
+    Positions the reader so that the next chunk read is the first chunk with the given or later tick.
+    Uses the index to skip most of the file, then scans chunk headers from the nearest indexed chunk.
+
+    @return True on success, false if there is no chunk with the given or later tick, or no file is open.
+            In case of failure, next() returns false until rewind() or a successful seek().
+*/
+bool pfl::ReplayReader::seek(uint64_t nTick)
+{
+    if (!isOpen())
+    {
+        return false;
+    }
+
+    m_bCorrupt = false;
+
+    // last indexed chunk before the given tick, chunks with the given tick might be before the first indexed chunk with it
+    const auto it = std::lower_bound(
+        m_index.begin(), m_index.end(), nTick,
+        [](const IndexEntry& entry, uint64_t nValue) { return entry.nTick < nValue; });
+    uint64_t nOffset = (it == m_index.begin()) ? sizeof(FileHeader) : (it - 1)->nOffset;
+
+    ReplayChunk chunk;
+    uint64_t nNextOffset;
+    while ((nOffset < m_nDataEnd) && parseChunk(nOffset, chunk, nNextOffset, false))
+    {
+        if (chunk.nTick >= nTick)
+        {
+            m_nPos = nOffset;
+            return true;
+        }
+        nOffset = nNextOffset;
+    }
+
+    m_nPos = m_nDataEnd;
+    return false;
+} // seek()
+
+
+// ############################## PROTECTED ##############################
+
+
+// ############################### PRIVATE ###############################
+
+
+/**
+    Hands the current buffer over to the background thread and gets an empty one, blocking if all buffers are in use.
+*/
+void pfl::ReplayWriter::submitCurrent()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cvDone.wait(lock, [this] { return !m_free.empty() || (m_nBuffers < m_nBufferCount); });
+
+    m_queue.push_back(std::move(m_current));
+    if (!m_free.empty())
+    {
+        m_current = std::move(m_free.back());
+        m_free.pop_back();
+    }
+    else
+    {
+        m_current = std::vector<char>();
+        m_current.reserve(m_nBufferSize);
+        m_nBuffers++;
+    }
+    m_current.clear();
+
+    lock.unlock();
+    m_cvWork.notify_one();
+} // submitCurrent()
+
+
+/**
+    Background thread: fills in the checksums of the chunks in the queued buffers and writes the buffers to the file.
+    Exits when stopping and the queue is empty.
+*/
+void pfl::ReplayWriter::threadFunc()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_cvWork.wait(lock, [this] { return m_bStop || !m_queue.empty(); });
+        if (m_queue.empty())
+        {
+            break;
+        }
+
+        std::vector<char> buffer = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_bWriting = true;
+        // chunks after a failed write would follow a gap in the file, so they are dropped
+        const bool bSkip = m_bError;
+        lock.unlock();
+
+        bool bOk = true;
+        if (!bSkip)
+        {
+            size_t nOffset = 0;
+            while (nOffset < buffer.size())
+            {
+                ChunkHeader header;
+                memcpy(&header, buffer.data() + nOffset, sizeof(header));
+                header.nCrc = calcChunkCrc(header, buffer.data() + nOffset + sizeof(header));
+                memcpy(buffer.data() + nOffset + offsetof(ChunkHeader, nCrc), &header.nCrc, sizeof(header.nCrc));
+                nOffset += static_cast<size_t>(sizeof(header) + alignChunkSize(header.nSize));
+            }
+            bOk = (fwrite(buffer.data(), 1, buffer.size(), m_pFile) == buffer.size());
+        }
+
+        buffer.clear();
+        lock.lock();
+        if (!bOk)
+        {
+            m_bError = true;
+        }
+        m_free.push_back(std::move(buffer));
+        m_bWriting = false;
+        m_cvDone.notify_all();
+    }
+} // threadFunc()
+
+
+/**
+    Parses the chunk at the given offset.
+
+    @param bVerify If true, checksum of the chunk is verified too.
+
+    @return True on success, false if the chunk is incomplete or its checksum is wrong.
+*/
+bool pfl::ReplayReader::parseChunk(uint64_t nOffset, ReplayChunk& chunk, uint64_t& nNextOffset, bool bVerify) const
+{
+    if ((nOffset > m_nDataEnd) || (m_nDataEnd - nOffset < sizeof(ChunkHeader)))
+    {
+        return false;
+    }
+
+    ChunkHeader header;
+    const char* const pChunk = m_file.data() + nOffset;
+    memcpy(&header, pChunk, sizeof(header));
+    const uint64_t nChunkSize = sizeof(ChunkHeader) + alignChunkSize(header.nSize);
+    if (m_nDataEnd - nOffset < nChunkSize)
+    {
+        return false;
+    }
+    if (bVerify && (calcChunkCrc(header, pChunk + sizeof(header)) != header.nCrc))
+    {
+        return false;
+    }
+
+    chunk.nType = header.nType;
+    chunk.nTick = header.nTick;
+    chunk.pData = pChunk + sizeof(header);
+    chunk.nSize = header.nSize;
+    nNextOffset = nOffset + nChunkSize;
+    return true;
+} // parseChunk()
@@ -0,0 +1,223 @@
+#pragma once
+
+/*
+    ###################################################################################
+    ReplayFile.h
+    Append-only chunked binary file format for recording and replaying per-tick data.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "MappedFile.h"
+
+namespace pfl
+{
+    /**
+    * A chunk read from a replay file by ReplayReader.
+    */
+    struct ReplayChunk
+    {
+        uint32_t    nType;  /**< User-defined type of the chunk, e.g. player input or world snapshot. */
+        uint64_t    nTick;  /**< Tick the chunk belongs to. */
+        const char* pData;  /**< Points into the mapped file, valid until the reader is closed. Aligned to 8 bytes. */
+        size_t      nSize;
+    };
+
+    /**
+    * Writes replay files: a sequence of chunks of arbitrary data, each tagged with a type and a tick number, e.g. the per-tick
+    * inputs and periodic snapshots of a game session, for replays and bug reproduction.
+    *
+    * write() only copies the chunk into a big buffer, full buffers are checksummed and written to the file by a background thread
+    * in large sequential writes, so recording can be always on even on a production server. Ticks of chunks must not decrease.
+    *
+    * File layout (little-endian): 16-byte header ("PFLR", version), then chunks, then the index and a 32-byte footer.
+    * Each chunk has a 24-byte header (type, size, tick, CRC-32C of header and data), data padded to 8 bytes.
+    * The index is a list of (tick, offset) pairs of every chunk starting after at least IndexInterval bytes since the previous
+    * indexed chunk, so the reader can seek to a tick without scanning the whole file.
+    * If the writer is not closed properly, e.g. the server crashes, the file has no index, but ReplayReader still reads all
+    * complete chunks.
+    */
+    class ReplayWriter
+    {
+
+    public:
+
+        static constexpr uint32_t Version = 1;
+        static constexpr size_t IndexInterval = 64 * 1024;  /**< Approximate number of bytes between indexed chunks. */
+
+        ReplayWriter() = default;
+        ~ReplayWriter();
+
+        ReplayWriter(const ReplayWriter&) = delete;
+        ReplayWriter& operator=(const ReplayWriter&) = delete;
+        ReplayWriter(ReplayWriter&&) = delete;
+        ReplayWriter& operator=(ReplayWriter&&) = delete;
+
+        bool open(
+            const char* path,
+            size_t nBufferSize = 1024 * 1024,
+            size_t nBufferCount = 4);                /**< Creates the given file and starts the background writer thread. */
+        bool close();                                /**< Writes all pending chunks and the index, and closes the file. */
+        bool flush();                                /**< Blocks until all chunks written so far are in the file. */
+
+        bool write(
+            uint32_t nType, uint64_t nTick,
+            const void* pData, size_t nSize);        /**< Appends a chunk. */
+
+        /**
+        * Appends the given trivially copyable object as a chunk.
+        * @return True on success, false if the tick is less than the tick of the previous chunk or the file is not open.
+        */
+        template <typename T>
+        bool write(uint32_t nType, uint64_t nTick, const T& data)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Chunk data must be trivially copyable!");
+            return write(nType, nTick, &data, sizeof(T));
+        }
+
+        bool isOpen() const
+        {
+            return m_pFile != nullptr;
+        }
+
+        /**
+        * @return True if writing the file has failed since open(), e.g. the disk is full. Chunks written after the error are lost.
+        */
+        bool hasError() const;
+
+        /**
+        * @return Number of chunks written since open().
+        */
+        uint64_t numChunks() const
+        {
+            return m_nChunks;
+        }
+
+        /**
+        * @return Size of the file with all chunks written so far, not including the index.
+        */
+        uint64_t size() const
+        {
+            return m_nFileSize;
+        }
+
+    private:
+
+        struct IndexEntry
+        {
+            uint64_t nTick;
+            uint64_t nOffset;
+        };
+
+        FILE* m_pFile = nullptr;
+        size_t m_nBufferSize = 0;
+        size_t m_nBufferCount = 0;                  /**< Max number of buffers, including the one being filled. */
+        std::vector<char> m_current;                /**< Buffer being filled by write(). */
+        uint64_t m_nFileSize = 0;                   /**< Including m_current. */
+        uint64_t m_nChunks = 0;
+        uint64_t m_nLastTick = 0;
+        uint64_t m_nLastIndexedOffset = 0;
+        std::vector<IndexEntry> m_index;
+
+        std::thread m_thread;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cvWork;           /**< Signaled when a buffer is queued or stopping. */
+        std::condition_variable m_cvDone;           /**< Signaled when a buffer has been written. */
+        std::deque<std::vector<char>> m_queue;      /**< Full buffers waiting to be written. */
+        std::vector<std::vector<char>> m_free;      /**< Written buffers, reused by write(). */
+        size_t m_nBuffers = 0;                      /**< Number of buffers allocated so far. */
+        bool m_bWriting = false;                    /**< Background thread is writing a buffer taken from m_queue. */
+        bool m_bStop = false;
+        bool m_bError = false;
+
+        void submitCurrent();
+        void threadFunc();
+
+    }; // class ReplayWriter
+
+    /**
+    * Reads replay files written by ReplayWriter.
+    * The file is memory-mapped, chunk data is accessed without copying. Checksum of each chunk is verified when read.
+    */
+    class ReplayReader
+    {
+
+    public:
+
+        ReplayReader() = default;
+        ~ReplayReader() = default;
+
+        ReplayReader(const ReplayReader&) = delete;
+        ReplayReader& operator=(const ReplayReader&) = delete;
+        ReplayReader(ReplayReader&&) = default;
+        ReplayReader& operator=(ReplayReader&&) = default;
+
+        bool open(const char* path);        /**< Opens and validates the given replay file. */
+        void close();                       /**< Closes the file. */
+
+        bool next(ReplayChunk& chunk);      /**< Reads the next chunk, if any. */
+        void rewind();                      /**< Continues reading from the first chunk. */
+        bool seek(uint64_t nTick);          /**< Continues reading from the first chunk with the given or later tick. */
+
+        bool isOpen() const
+        {
+            return m_file.isOpen();
+        }
+
+        /**
+        * @return Number of complete chunks in the file.
+        */
+        uint64_t numChunks() const
+        {
+            return m_nChunks;
+        }
+
+        /**
+        * @return True if the file has no valid index, e.g. the writer has crashed, so the chunks have been scanned by open().
+        */
+        bool isRecovered() const
+        {
+            return m_bRecovered;
+        }
+
+        /**
+        * @return True if next() has found a chunk with bad checksum. Following chunks are not read.
+        */
+        bool isCorrupt() const
+        {
+            return m_bCorrupt;
+        }
+
+    private:
+
+        struct IndexEntry
+        {
+            uint64_t nTick;
+            uint64_t nOffset;
+        };
+
+        MappedFile m_file;
+        std::vector<IndexEntry> m_index;
+        uint64_t m_nDataEnd = 0;            /**< Offset of the end of the last chunk. */
+        uint64_t m_nPos = 0;                /**< Offset of the next chunk to be read. */
+        uint64_t m_nChunks = 0;
+        bool m_bRecovered = false;
+        bool m_bCorrupt = false;
+
+        bool parseChunk(uint64_t nOffset, ReplayChunk& chunk, uint64_t& nNextOffset, bool bVerify) const;
+
+    }; // class ReplayReader
+
+} // namespace
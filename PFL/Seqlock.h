@@ -0,0 +1,144 @@
+#pragma once
+
+/*
+    ###################################################################################
+    Seqlock.h
+    Sequence lock for sharing the latest value of a small trivially copyable object between threads.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace pfl
+{
+    /**
+    * Sequence lock: holds the latest value of a small trivially copyable object, written by a single writer thread and read by any
+    * number of reader threads.
+    *
+    * The writer never waits: it makes the sequence number odd, writes the value and makes the sequence number even again.
+    * A reader copies the value and retries if the sequence number was odd or changed meanwhile, so readers never block the writer,
+    * but a reader might need to retry while the writer is writing. Good for values written often and read often, like the latest
+    * camera transform or live server stats; for big values use TripleBuffer instead, as a reader copies the whole value each try.
+    *
+    * The value is stored as relaxed atomic 64-bit words, so torn reads are detected and discarded without any data race.
+    */
+    template <typename T>
+    class Seqlock
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Seqlock value must be trivially copyable!");
+
+    public:
+
+        Seqlock() :
+            Seqlock(T())
+        {}
+
+        explicit Seqlock(const T& value)
+        {
+            m_nSequence.store(0, std::memory_order_relaxed);
+            writeWords(value);
+        }
+
+        ~Seqlock() = default;
+
+        Seqlock(const Seqlock&) = delete;
+        Seqlock& operator=(const Seqlock&) = delete;
+        Seqlock(Seqlock&&) = delete;
+        Seqlock& operator=(Seqlock&&) = delete;
+
+        /**
+        * Sets the value. Wait-free.
+        * Must be invoked only by a single writer thread at a time.
+        */
+        void store(const T& value)
+        {
+            const uint64_t nSequence = m_nSequence.load(std::memory_order_relaxed);
+            m_nSequence.store(nSequence + 1, std::memory_order_relaxed);
+            // the odd sequence number must be visible before any word of the new value
+            std::atomic_thread_fence(std::memory_order_release);
+            writeWords(value);
+            m_nSequence.store(nSequence + 2, std::memory_order_release);
+        }
+
+        /**
+        * Gets the value, retrying while the writer is writing it. Lock-free, never blocks the writer.
+        * Thread-safe.
+        */
+        T load() const
+        {
+            T value;
+            while (!tryLoad(value))
+            {
+            }
+            return value;
+        }
+
+        /**
+        * Tries getting the value once.
+        * Thread-safe.
+        *
+        * @param value Set to the value if successful, unspecified otherwise.
+        *
+        * @return True if successful, false if the writer was writing meanwhile.
+        */
+        bool tryLoad(T& value) const
+        {
+            const uint64_t nSequenceBefore = m_nSequence.load(std::memory_order_acquire);
+            if (nSequenceBefore & 1u)
+            {
+                return false;
+            }
+
+            uint64_t aWords[NumWords];
+            for (size_t i = 0; i < NumWords; i++)
+            {
+                aWords[i] = m_aWords[i].load(std::memory_order_relaxed);
+            }
+            // reading the words must complete before checking the sequence number again
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_nSequence.load(std::memory_order_relaxed) != nSequenceBefore)
+            {
+                return false;
+            }
+
+            std::memcpy(&value, aWords, sizeof(T));
+            return true;
+        }
+
+        /**
+        * @return Number of store() calls so far. Thread-safe.
+        */
+        uint64_t version() const
+        {
+            return m_nSequence.load(std::memory_order_acquire) / 2;
+        }
+
+    private:
+        static constexpr size_t NumWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        std::atomic<uint64_t> m_nSequence;
+        std::atomic<uint64_t> m_aWords[NumWords];
+
+        void writeWords(const T& value)
+        {
+            uint64_t aWords[NumWords] = {};
+            std::memcpy(aWords, &value, sizeof(T));
+            for (size_t i = 0; i < NumWords; i++)
+            {
+                m_aWords[i].store(aWords[i], std::memory_order_relaxed);
+            }
+        }
+
+    }; // class Seqlock
+
+    template <typename T>
+    constexpr size_t Seqlock<T>::NumWords;
+
+} // namespace
@@ -0,0 +1,528 @@
+/*
+    ###################################################################################
+    ShmTelemetryRing.cpp
+    Single-writer ring of fixed-size records in named shared memory, readable from other processes.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include "ShmTelemetryRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include "winproof88.h"
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace
+{
+    constexpr uint32_t nSegmentMagic = 0x544C4650;  /**< "PFLT" */
+
+    /**
+        Start of the segment. Config fields are written before nMagic is set, and never change after that.
+        The write count has its own cache line, as it is written by the writer for every record and read by all readers.
+    */
+    struct SegmentHeader
+    {
+        std::atomic<uint32_t> nMagic;
+        uint32_t nVersion;
+        uint32_t nHeaderSize;
+        uint32_t nSlotSize;
+        uint32_t nSlotCount;
+        uint32_t nSlotStride;
+        uint32_t nWriterPid;                /**< Process id of the writer, written before the magic, to detect a crashed writer. */
+        char padding0[36];
+        std::atomic<uint64_t> nWriteCount;  /**< Number of records completely written. */
+        std::atomic<uint32_t> nClosed;
+        char padding1[52];
+    };
+
+    static_assert(sizeof(SegmentHeader) == 128, "Layout of shared memory segment must not depend on the compiler!");
+
+    /**
+        Start of each slot, followed by the record data.
+    */
+    struct SlotHeader
+    {
+        std::atomic<uint64_t> nSequence;    /**< 2k+1 while record number k is being written, 2k+2 when it is complete. */
+        uint32_t nSize;
+        uint32_t nReserved;
+    };
+
+    static_assert(sizeof(SlotHeader) == 16, "Layout of shared memory segment must not depend on the compiler!");
+
+    size_t roundUp(size_t nValue, size_t nAlignment)
+    {
+        return (nValue + nAlignment - 1) / nAlignment * nAlignment;
+    } // roundUp()
+
+    size_t roundUpToPowerOf2(size_t nValue)
+    {
+        size_t nResult = 1;
+        while (nResult < nValue)
+        {
+            nResult *= 2;
+        }
+        return nResult;
+    } // roundUpToPowerOf2()
+
+#ifndef _WIN32
+    /**
+        @return Name of the POSIX shared memory object, which must start with a slash.
+    */
+    std::string toShmName(const char* pszName)
+    {
+        return (pszName[0] == '/') ? std::string(pszName) : (std::string("/") + pszName);
+    } // toShmName()
+
+    /**
+        Tells if the existing segment with the given name is still used by a writer.
+        A segment whose writer has exited without close() is not in use. A segment being created right now is in use,
+        but so is one whose writer crashed in the middle of create(), since these cannot be told apart.
+    */
+    bool isSegmentInUse(const std::string& sName)
+    {
+        const int fd = shm_open(sName.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+        {
+            // removed since our open attempt, or not ours to decide about
+            return errno != ENOENT;
+        }
+
+        struct stat st;
+        if ((fstat(fd, &st) != 0) || (static_cast<size_t>(st.st_size) < sizeof(SegmentHeader)))
+        {
+            // size is set right after the object is created
+            ::close(fd);
+            return true;
+        }
+
+        void* const pMapped = mmap(nullptr, sizeof(SegmentHeader), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (pMapped == MAP_FAILED)
+        {
+            return true;
+        }
+
+        const SegmentHeader* const pHeader = static_cast<const SegmentHeader*>(pMapped);
+        bool bInUse = true;
+        if (pHeader->nMagic.load(std::memory_order_acquire) == nSegmentMagic)
+        {
+            // EPERM means the process exists, just belongs to someone else
+            const pid_t pid = static_cast<pid_t>(pHeader->nWriterPid);
+            bInUse = (pHeader->nClosed.load(std::memory_order_acquire) == 0) && ((kill(pid, 0) == 0) || (errno == EPERM));
+        }
+        munmap(pMapped, sizeof(SegmentHeader));
+        return bInUse;
+    } // isSegmentInUse()
+#endif
+
+} // namespace
+
+
+constexpr uint32_t pfl::ShmTelemetryWriter::FormatVersion;
+
+
+// ############################### PUBLIC ################################
+
+
+pfl::ShmTelemetryWriter::~ShmTelemetryWriter()
+{
+    close();
+}
+
+
+/**
+    Creates the shared memory segment with the given name, and maps it.
+    A stale segment with the same name left by a crashed writer is replaced; readers still mapping it are not affected.
+    A segment of a live writer is never replaced.
+    Any previously created segment of this writer is closed first.
+
+    @param pszName    Name of the segment: a POSIX shared memory object name, or a Windows named file mapping object name.
+    @param nSlotSize  Max size of a record in bytes.
+                      Must be positive.
+                      Exception is thrown for zero value.
+    @param nSlotCount Number of records kept, rounded up to power of 2.
+                      Must be positive.
+                      Exception is thrown for zero value.
+
+    @return True on success, false if the segment cannot be created, e.g. another writer is using the same name.
+*/
+bool pfl::ShmTelemetryWriter::create(const char* pszName, size_t nSlotSize, size_t nSlotCount)
+{
+    close();
+
+    if (!nSlotSize || !nSlotCount)
+    {
+        throw std::runtime_error("Slot size and slot count must be positive!");
+    }
+
+    const size_t nSlotCountPow2 = roundUpToPowerOf2(nSlotCount);
+    const size_t nSlotStride = roundUp(sizeof(SlotHeader) + nSlotSize, 64);
+    const size_t nSize = sizeof(SegmentHeader) + nSlotStride * nSlotCountPow2;
+
+#ifdef _WIN32
+    const HANDLE hMapping = CreateFileMappingA(
+        INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+        static_cast<DWORD>(static_cast<uint64_t>(nSize) >> 32), static_cast<DWORD>(nSize & 0xFFFFFFFFu), pszName);
+    if (hMapping == NULL)
+    {
+        return false;
+    }
+    if (GetLastError() == ERROR_ALREADY_EXISTS)
+    {
+        // on Windows the segment lives as long as anyone has it open, so this is not necessarily a live writer, but we cannot replace it
+        CloseHandle(hMapping);
+        return false;
+    }
+
+    void* const pMapped = MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, nSize);
+    if (!pMapped)
+    {
+        CloseHandle(hMapping);
+        return false;
+    }
+    m_hMapping = hMapping;
+#else
+    const std::string sName = toShmName(pszName);
+    const mode_t nMode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+    int fd = shm_open(sName.c_str(), O_CREAT | O_EXCL | O_RDWR, nMode);
+    if ((fd < 0) && (errno == EEXIST) && !isSegmentInUse(sName))
+    {
+        shm_unlink(sName.c_str());
+        fd = shm_open(sName.c_str(), O_CREAT | O_EXCL | O_RDWR, nMode);
+    }
+    if (fd < 0)
+    {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(nSize)) != 0)
+    {
+        ::close(fd);
+        shm_unlink(sName.c_str());
+        return false;
+    }
+
+    // the mapping keeps a reference to the object, fd can be closed right after mapping
+    void* const pMapped = mmap(nullptr, nSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (pMapped == MAP_FAILED)
+    {
+        shm_unlink(sName.c_str());
+        return false;
+    }
+    m_sName = sName;
+#endif
+
+    // memory of a new segment is zeroed by the OS
+    SegmentHeader* const pHeader = static_cast<SegmentHeader*>(pMapped);
+    new (&pHeader->nWriteCount) std::atomic<uint64_t>(0);
+    new (&pHeader->nClosed) std::atomic<uint32_t>(0);
+    pHeader->nVersion = FormatVersion;
+    pHeader->nHeaderSize = sizeof(SegmentHeader);
+    pHeader->nSlotSize = static_cast<uint32_t>(nSlotSize);
+    pHeader->nSlotCount = static_cast<uint32_t>(nSlotCountPow2);
+    pHeader->nSlotStride = static_cast<uint32_t>(nSlotStride);
+#ifdef _WIN32
+    pHeader->nWriterPid = static_cast<uint32_t>(GetCurrentProcessId());
+#else
+    pHeader->nWriterPid = static_cast<uint32_t>(getpid());
+#endif
+    for (size_t i = 0; i < nSlotCountPow2; i++)
+    {
+        new (static_cast<char*>(pMapped) + sizeof(SegmentHeader) + i * nSlotStride) SlotHeader{ {0}, 0, 0 };
+    }
+    // readers check the magic first, so it must be the last to become visible
+    new (&pHeader->nMagic) std::atomic<uint32_t>(0);
+    pHeader->nMagic.store(nSegmentMagic, std::memory_order_release);
+
+    m_pBase = static_cast<char*>(pMapped);
+    m_nMappedSize = nSize;
+    m_nSlotSize = nSlotSize;
+    m_nSlotCount = nSlotCountPow2;
+    m_nSlotStride = nSlotStride;
+    m_nWritten = 0;
+    return true;
+} // create()
+
+
+/**
+    Marks the ring closed, so readers can tell the writer is gone, then unmaps and removes the segment.
+    Readers already mapping the segment can still read the records left in it.
+*/
+void pfl::ShmTelemetryWriter::close()
+{
+    if (!m_pBase)
+    {
+        return;
+    }
+
+    reinterpret_cast<SegmentHeader*>(m_pBase)->nClosed.store(1, std::memory_order_release);
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_pBase);
+    CloseHandle(static_cast<HANDLE>(m_hMapping));
+    m_hMapping = nullptr;
+#else
+    munmap(m_pBase, m_nMappedSize);
+    shm_unlink(m_sName.c_str());
+    m_sName.clear();
+#endif
+
+    m_pBase = nullptr;
+    m_nMappedSize = 0;
+} // close()
+
+
+/**
+    Appends a record, overwriting the oldest one if the ring is full. Wait-free.
+    Must be invoked only by a single thread at a time.
+
+    @return True on success, false if the record is bigger than the slot size or the ring is not created.
+*/
+bool pfl::ShmTelemetryWriter::push(const void* pData, size_t nSize)
+{
+    if (!m_pBase || (nSize > m_nSlotSize))
+    {
+        return false;
+    }
+
+    char* const pSlot = m_pBase + sizeof(SegmentHeader) + static_cast<size_t>(m_nWritten & (m_nSlotCount - 1)) * m_nSlotStride;
+    SlotHeader* const pSlotHeader = reinterpret_cast<SlotHeader*>(pSlot);
+
+    pSlotHeader->nSequence.store(2 * m_nWritten + 1, std::memory_order_relaxed);
+    // the odd sequence number must be visible before any byte of the new record
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(pSlot + sizeof(SlotHeader), pData, nSize);
+    pSlotHeader->nSize = static_cast<uint32_t>(nSize);
+    pSlotHeader->nSequence.store(2 * m_nWritten + 2, std::memory_order_release);
+
+    m_nWritten++;
+    reinterpret_cast<SegmentHeader*>(m_pBase)->nWriteCount.store(m_nWritten, std::memory_order_release);
+    return true;
+} // push()
+
+
+pfl::ShmTelemetryReader::~ShmTelemetryReader()
+{
+    close();
+}
+
+
+/**
+    Maps the existing segment with the given name read-only. Reading starts from the oldest record still in the ring.
+    Any previously opened segment is closed first.
+
+    @return True on success, false if the segment does not exist, is not yet initialized, or has incompatible format.
+*/
+bool pfl::ShmTelemetryReader::open(const char* pszName)
+{
+    close();
+
+#ifdef _WIN32
+    const HANDLE hMapping = OpenFileMappingA(FILE_MAP_READ, FALSE, pszName);
+    if (hMapping == NULL)
+    {
+        return false;
+    }
+    // the view keeps the mapping alive, the handle can be closed right after mapping
+    const void* const pMapped = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(hMapping);
+    if (!pMapped)
+    {
+        return false;
+    }
+    MEMORY_BASIC_INFORMATION info;
+    const size_t nSize = (VirtualQuery(pMapped, &info, sizeof(info)) == sizeof(info)) ? info.RegionSize : 0;
+#else
+    const int fd = shm_open(toShmName(pszName).c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (static_cast<size_t>(st.st_size) < sizeof(SegmentHeader)))
+    {
+        ::close(fd);
+        return false;
+    }
+    const size_t nSize = static_cast<size_t>(st.st_size);
+    const void* const pMapped = mmap(nullptr, nSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (pMapped == MAP_FAILED)
+    {
+        return false;
+    }
+#endif
+
+    m_pBase = static_cast<const char*>(pMapped);
+    m_nMappedSize = nSize;
+
+    const SegmentHeader* const pHeader = static_cast<const SegmentHeader*>(pMapped);
+    const bool bValid =
+        (nSize >= sizeof(SegmentHeader)) &&
+        (pHeader->nMagic.load(std::memory_order_acquire) == nSegmentMagic) &&
+        (pHeader->nVersion == ShmTelemetryWriter::FormatVersion) &&
+        (pHeader->nHeaderSize == sizeof(SegmentHeader)) &&
+        (pHeader->nSlotSize > 0) &&
+        (pHeader->nSlotCount > 0) &&
+        ((pHeader->nSlotCount & (pHeader->nSlotCount - 1)) == 0) &&
+        (pHeader->nSlotStride >= sizeof(SlotHeader) + pHeader->nSlotSize) &&
+        (sizeof(SegmentHeader) + static_cast<uint64_t>(pHeader->nSlotStride) * pHeader->nSlotCount <= nSize);
+    if (!bValid)
+    {
+        close();
+        return false;
+    }
+
+    m_nSlotSize = pHeader->nSlotSize;
+    m_nSlotCount = pHeader->nSlotCount;
+    m_nSlotStride = pHeader->nSlotStride;
+    const uint64_t nWriteCount = pHeader->nWriteCount.load(std::memory_order_acquire);
+    m_nNext = (nWriteCount > m_nSlotCount) ? (nWriteCount - m_nSlotCount) : 0;
+    m_nLost = 0;
+    return true;
+} // open()
+
+
+void pfl::ShmTelemetryReader::close()
+{
+    if (!m_pBase)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_pBase);
+#else
+    munmap(const_cast<char*>(m_pBase), m_nMappedSize);
+#endif
+
+    m_pBase = nullptr;
+    m_nMappedSize = 0;
+    m_nSlotSize = 0;
+    m_nSlotCount = 0;
+    m_nSlotStride = 0;
+} // close()
+
+
+/**
+    Reads the next record, if any. Records overwritten by the writer before being read are skipped and counted by getLostCount().
+
+    @param pBuffer     Receives the record. If the record is bigger than the buffer, only the beginning of it is copied.
+    @param nBufferSize Size of pBuffer.
+    @param nSize       Set to the size of the record.
+
+    @return True if a record has been read, false if there is no unread record or nothing is opened.
+*/
+bool pfl::ShmTelemetryReader::tryRead(void* pBuffer, size_t nBufferSize, size_t& nSize)
+{
+    if (!m_pBase)
+    {
+        return false;
+    }
+
+    const SegmentHeader* const pHeader = reinterpret_cast<const SegmentHeader*>(m_pBase);
+    for (;;)
+    {
+        const uint64_t nWriteCount = pHeader->nWriteCount.load(std::memory_order_acquire);
+        if (m_nNext >= nWriteCount)
+        {
+            return false;
+        }
+        if (nWriteCount - m_nNext > m_nSlotCount)
+        {
+            // the writer has lapped us
+            m_nLost += nWriteCount - m_nSlotCount - m_nNext;
+            m_nNext = nWriteCount - m_nSlotCount;
+        }
+
+        const char* const pSlot = m_pBase + sizeof(SegmentHeader) + static_cast<size_t>(m_nNext & (m_nSlotCount - 1)) * m_nSlotStride;
+        const SlotHeader* const pSlotHeader = reinterpret_cast<const SlotHeader*>(pSlot);
+        const uint64_t nExpectedSequence = 2 * m_nNext + 2;
+
+        const uint64_t nSequenceBefore = pSlotHeader->nSequence.load(std::memory_order_acquire);
+        bool bOk = (nSequenceBefore == nExpectedSequence);
+        if (bOk)
+        {
+            const size_t nRecordSize = pSlotHeader->nSize;
+            std::memcpy(pBuffer, pSlot + sizeof(SlotHeader), std::min(std::min(nRecordSize, m_nSlotSize), nBufferSize));
+            // copying must complete before checking the sequence number again
+            std::atomic_thread_fence(std::memory_order_acquire);
+            bOk = (pSlotHeader->nSequence.load(std::memory_order_relaxed) == nExpectedSequence) && (nRecordSize <= m_nSlotSize);
+            nSize = nRecordSize;
+        }
+
+        m_nNext++;
+        if (bOk)
+        {
+            return true;
+        }
+        // overwritten before or while copying
+        m_nLost++;
+    }
+} // tryRead()
+
+
+/**
+    Skips unread records except the given number of newest ones, e.g. a dashboard only interested in the latest values.
+    Skipped records are not counted as lost.
+*/
+void pfl::ShmTelemetryReader::skipToLatest(size_t nRecords)
+{
+    if (!m_pBase)
+    {
+        return;
+    }
+
+    const uint64_t nWriteCount = reinterpret_cast<const SegmentHeader*>(m_pBase)->nWriteCount.load(std::memory_order_acquire);
+    if (nWriteCount - m_nNext > nRecords)
+    {
+        m_nNext = nWriteCount - nRecords;
+    }
+} // skipToLatest()
+
+
+/**
+    @return Number of unread records still in the ring, at most the slot count. Some of them might be overwritten before read.
+*/
+uint64_t pfl::ShmTelemetryReader::numAvailable() const
+{
+    if (!m_pBase)
+    {
+        return 0;
+    }
+
+    const uint64_t nWriteCount = reinterpret_cast<const SegmentHeader*>(m_pBase)->nWriteCount.load(std::memory_order_acquire);
+    return std::min<uint64_t>(nWriteCount - m_nNext, m_nSlotCount);
+} // numAvailable()
+
+
+/**
+    @return True if the writer has closed the ring, e.g. the server has exited. The segment could be re-opened by name later,
+            to follow a restarted writer.
+*/
+bool pfl::ShmTelemetryReader::isWriterClosed() const
+{
+    return m_pBase && (reinterpret_cast<const SegmentHeader*>(m_pBase)->nClosed.load(std::memory_order_acquire) != 0);
+} // isWriterClosed()
+
+
+// ############################## PROTECTED ##############################
+
+
+// ############################### PRIVATE ###############################
@@ -0,0 +1,171 @@
+#pragma once
+
+/*
+    ###################################################################################
+    ShmTelemetryRing.h
+    Single-writer ring of fixed-size records in named shared memory, readable from other processes.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace pfl
+{
+    /**
+    * Writer side of a telemetry ring in named shared memory, e.g. for frame timings and counters of a server, read live by
+    * a separate dashboard process without any socket or locking.
+    *
+    * Like FixFIFO, it is a fixed-capacity ring of slots, but the writer never waits for readers: when the ring is full, the oldest
+    * record is overwritten. Each slot has a sequence number, so readers detect records overwritten while or before being read.
+    * Pushing a record costs a memcpy into the mapped memory and 3 atomic stores.
+    *
+    * The segment starts with a versioned header describing the layout, so readers built from a different version of this code
+    * refuse to open an incompatible segment.
+    */
+    class ShmTelemetryWriter
+    {
+
+    public:
+
+        static constexpr uint32_t FormatVersion = 1;
+
+        ShmTelemetryWriter() = default;
+        ~ShmTelemetryWriter();
+
+        ShmTelemetryWriter(const ShmTelemetryWriter&) = delete;
+        ShmTelemetryWriter& operator=(const ShmTelemetryWriter&) = delete;
+        ShmTelemetryWriter(ShmTelemetryWriter&&) = delete;
+        ShmTelemetryWriter& operator=(ShmTelemetryWriter&&) = delete;
+
+        bool create(const char* pszName, size_t nSlotSize, size_t nSlotCount);  /**< Creates the shared memory segment with the given name. */
+        void close();                                                          /**< Marks the ring closed for readers and releases the segment. */
+
+        bool push(const void* pData, size_t nSize);                            /**< Appends a record, overwriting the oldest one if the ring is full. */
+
+        /**
+        * Appends the given trivially copyable object as a record.
+        * @return True on success, false if the object is bigger than the slot size or the ring is not created.
+        */
+        template <typename T>
+        bool push(const T& record)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Telemetry record must be trivially copyable!");
+            return push(&record, sizeof(T));
+        }
+
+        bool isOpen() const
+        {
+            return m_pBase != nullptr;
+        }
+
+        size_t slotSize() const
+        {
+            return m_nSlotSize;
+        }
+
+        size_t slotCount() const
+        {
+            return m_nSlotCount;
+        }
+
+        /**
+        * @return Number of records pushed since creation.
+        */
+        uint64_t numWritten() const
+        {
+            return m_nWritten;
+        }
+
+    private:
+        char* m_pBase = nullptr;
+        size_t m_nMappedSize = 0;
+        size_t m_nSlotSize = 0;
+        size_t m_nSlotCount = 0;
+        size_t m_nSlotStride = 0;
+        uint64_t m_nWritten = 0;
+        void* m_hMapping = nullptr;  /**< Handle of the file mapping on Windows, keeping the named segment alive. */
+        std::string m_sName;
+
+    }; // class ShmTelemetryWriter
+
+    /**
+    * Reader side of a telemetry ring created by ShmTelemetryWriter, possibly in another process.
+    * Maps the segment read-only, so readers cannot disturb the writer. Any number of readers can read the same ring, each
+    * having its own read position.
+    */
+    class ShmTelemetryReader
+    {
+
+    public:
+
+        ShmTelemetryReader() = default;
+        ~ShmTelemetryReader();
+
+        ShmTelemetryReader(const ShmTelemetryReader&) = delete;
+        ShmTelemetryReader& operator=(const ShmTelemetryReader&) = delete;
+        ShmTelemetryReader(ShmTelemetryReader&&) = delete;
+        ShmTelemetryReader& operator=(ShmTelemetryReader&&) = delete;
+
+        bool open(const char* pszName);                                 /**< Maps the existing segment with the given name. */
+        void close();                                                   /**< Unmaps the segment. */
+
+        bool tryRead(void* pBuffer, size_t nBufferSize, size_t& nSize);  /**< Reads the next record, if any. */
+
+        /**
+        * Reads the next record into the given trivially copyable object.
+        * @return True if a record has been read, false if there is no unread record.
+        *         If the record is smaller than the object, the rest of the object is left untouched.
+        */
+        template <typename T>
+        bool tryRead(T& record)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Telemetry record must be trivially copyable!");
+            size_t nSize;
+            return tryRead(&record, sizeof(T), nSize);
+        }
+
+        void skipToLatest(size_t nRecords = 0);                         /**< Skips unread records except the given number of newest ones. */
+        uint64_t numAvailable() const;                                  /**< Gets the number of unread records still in the ring. */
+        bool isWriterClosed() const;                                    /**< Tells if the writer has closed the ring. */
+
+        bool isOpen() const
+        {
+            return m_pBase != nullptr;
+        }
+
+        size_t slotSize() const
+        {
+            return m_nSlotSize;
+        }
+
+        size_t slotCount() const
+        {
+            return m_nSlotCount;
+        }
+
+        /**
+        * @return Number of records overwritten by the writer before this reader could read them.
+        */
+        uint64_t getLostCount() const
+        {
+            return m_nLost;
+        }
+
+    private:
+        const char* m_pBase = nullptr;
+        size_t m_nMappedSize = 0;
+        size_t m_nSlotSize = 0;
+        size_t m_nSlotCount = 0;
+        size_t m_nSlotStride = 0;
+        uint64_t m_nNext = 0;        /**< Number of the next record to be read. */
+        uint64_t m_nLost = 0;
+
+    }; // class ShmTelemetryReader
+
+} // namespace
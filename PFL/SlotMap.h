@@ -0,0 +1,331 @@
+#pragma once
+
+/*
+    ###################################################################################
+    SlotMap.h
+    Fixed-capacity generational slot map: dense element storage addressed by index/generation handles.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace pfl
+{
+    /**
+    * Handle of an element in a SlotMap.
+    * Stays valid until the element is erased, after which it is detected as stale, even if the slot has been reused since then.
+    * Default-constructed handle is invalid.
+    */
+    struct SlotMapHandle
+    {
+        uint32_t index = 0;       /**< Index of the slot. */
+        uint32_t generation = 0;  /**< Generation of the slot when the element was inserted. Never 0 for handles returned by SlotMap. */
+
+        /**
+        * @return False for default-constructed handles and handles returned by a failed insert, true otherwise.
+        *         A valid handle might still be stale, use SlotMap::contains() to check that.
+        */
+        bool isValid() const
+        {
+            return generation != 0;
+        }
+
+        bool operator==(const SlotMapHandle& other) const
+        {
+            return (index == other.index) && (generation == other.generation);
+        }
+
+        bool operator!=(const SlotMapHandle& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    /**
+    * Fixed-capacity container of elements addressed by SlotMapHandle.
+    *
+    * Elements are stored contiguously (densely), so iterating over them is as fast as iterating over a vector; erasing moves the last
+    * element into the hole, so iteration order is not stable.
+    * Handles point to slots, and slots point to the dense elements. Each slot has a generation counter incremented on erase,
+    * so a handle to an erased element is detected by a single compare. Insert, erase and lookup are O(1).
+    *
+    * Cheap alternative to std::weak_ptr for referring to objects that might be destroyed: lookup is an array index and a compare,
+    * without reference counting.
+    *
+    * Not thread-safe.
+    */
+    template <typename T>
+    class SlotMap
+    {
+
+    public:
+
+        typedef typename std::vector<T>::iterator iterator;
+        typedef typename std::vector<T>::const_iterator const_iterator;
+
+        /**
+        * @param capacity Maximum number of elements to be stored in this container.
+        *                 Must be positive and less than 2^32-1.
+        *                 Exception is thrown for zero or too big value.
+        */
+        SlotMap(const size_t& capacity) :
+            m_nCapacity(capacity)
+        {
+            if (!capacity)
+            {
+                throw std::runtime_error("Capacity must be positive!");
+            }
+            if (capacity >= InvalidIndex)
+            {
+                throw std::runtime_error("Capacity is too big!");
+            }
+
+            m_slots.resize(capacity);
+            m_data.reserve(capacity);
+            m_denseToSlot.reserve(capacity);
+            linkFreeSlots();
+        }
+
+        ~SlotMap() = default;
+
+        SlotMap(const SlotMap&) = default;
+        SlotMap& operator=(const SlotMap&) = default;
+        SlotMap(SlotMap&&) = default;
+        SlotMap& operator=(SlotMap&&) = default;
+
+        /**
+        * @return Number of elements.
+        */
+        size_t size() const
+        {
+            return m_data.size();
+        }
+
+        /**
+        * @return Capacity of the container.
+        */
+        const size_t& capacity() const
+        {
+            return m_nCapacity;
+        }
+
+        /**
+        * @return True if the container is empty, false otherwise.
+        */
+        bool empty() const
+        {
+            return m_data.empty();
+        }
+
+        /**
+        * @return True if the container is full, false otherwise.
+        */
+        bool full() const
+        {
+            return m_data.size() == m_nCapacity;
+        }
+
+        /**
+        * Inserts a copy of the given element.
+        * Complexity: O(1) constant.
+        *
+        * @return Handle to the new element, or an invalid handle if the container is full.
+        */
+        SlotMapHandle insert(const T& value)
+        {
+            return emplace(value);
+        }
+
+        SlotMapHandle insert(T&& value)
+        {
+            return emplace(std::move(value));
+        }
+
+        /**
+        * Constructs a new element in place.
+        * Complexity: O(1) constant.
+        *
+        * @return Handle to the new element, or an invalid handle if the container is full.
+        */
+        template <typename... Args>
+        SlotMapHandle emplace(Args&&... args)
+        {
+            if (full())
+            {
+                return SlotMapHandle();
+            }
+
+            const uint32_t iSlot = m_iFreeHead;
+            Slot& slot = m_slots[iSlot];
+            m_data.emplace_back(std::forward<Args>(args)...);
+            m_denseToSlot.push_back(iSlot);
+            m_iFreeHead = slot.iDenseOrNextFree;
+            slot.iDenseOrNextFree = static_cast<uint32_t>(m_data.size() - 1);
+
+            SlotMapHandle handle;
+            handle.index = iSlot;
+            handle.generation = slot.generation;
+            return handle;
+        }
+
+        /**
+        * Erases the element referred by the given handle. The last element is moved into its place in the dense storage.
+        * Complexity: O(1) constant.
+        *
+        * @return True if the element was erased, false if the handle is invalid or stale.
+        */
+        bool erase(const SlotMapHandle& handle)
+        {
+            if (!contains(handle))
+            {
+                return false;
+            }
+
+            Slot& slot = m_slots[handle.index];
+            const uint32_t iDense = slot.iDenseOrNextFree;
+            const uint32_t iLastDense = static_cast<uint32_t>(m_data.size() - 1);
+            if (iDense != iLastDense)
+            {
+                m_data[iDense] = std::move(m_data[iLastDense]);
+                m_denseToSlot[iDense] = m_denseToSlot[iLastDense];
+                m_slots[m_denseToSlot[iDense]].iDenseOrNextFree = iDense;
+            }
+            m_data.pop_back();
+            m_denseToSlot.pop_back();
+
+            releaseSlot(handle.index);
+            return true;
+        }
+
+        /**
+        * Tells if the given handle refers to an existing element.
+        * Complexity: O(1) constant.
+        */
+        bool contains(const SlotMapHandle& handle) const
+        {
+            if ((handle.index >= m_nCapacity) || !handle.isValid())
+            {
+                return false;
+            }
+
+            // a free slot also has a generation, so a handle never returned by insert() could match it:
+            // the slot is used only if its dense element points back to it
+            const Slot& slot = m_slots[handle.index];
+            return (slot.generation == handle.generation) &&
+                (slot.iDenseOrNextFree < m_data.size()) &&
+                (m_denseToSlot[slot.iDenseOrNextFree] == handle.index);
+        }
+
+        /**
+        * Complexity: O(1) constant.
+        *
+        * @return Pointer to the element referred by the given handle, or nullptr if the handle is invalid or stale.
+        *         The pointer is invalidated by any insert or erase.
+        */
+        T* get(const SlotMapHandle& handle)
+        {
+            return contains(handle) ? &m_data[m_slots[handle.index].iDenseOrNextFree] : nullptr;
+        }
+
+        const T* get(const SlotMapHandle& handle) const
+        {
+            return contains(handle) ? &m_data[m_slots[handle.index].iDenseOrNextFree] : nullptr;
+        }
+
+        /**
+        * Removes all elements. All existing handles become stale.
+        */
+        void clear()
+        {
+            for (const uint32_t iSlot : m_denseToSlot)
+            {
+                bumpGeneration(m_slots[iSlot]);
+            }
+            m_data.clear();
+            m_denseToSlot.clear();
+            linkFreeSlots();
+        }
+
+        /**
+        * @return Handle of the element at the given position of the dense storage, e.g. for the element being visited during iteration.
+        */
+        SlotMapHandle handleAt(size_t iDense) const
+        {
+            assert(iDense < m_data.size());
+            SlotMapHandle handle;
+            handle.index = m_denseToSlot[iDense];
+            handle.generation = m_slots[handle.index].generation;
+            return handle;
+        }
+
+        /**
+        * @return The dense storage, i.e. size() contiguous elements in unspecified order.
+        */
+        T* data()
+        {
+            return m_data.data();
+        }
+
+        const T* data() const
+        {
+            return m_data.data();
+        }
+
+        iterator begin() { return m_data.begin(); }
+        const_iterator begin() const { return m_data.begin(); }
+        iterator end() { return m_data.end(); }
+        const_iterator end() const { return m_data.end(); }
+
+    private:
+        static const uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        struct Slot
+        {
+            uint32_t iDenseOrNextFree = InvalidIndex;  /**< Index into m_data if used, index of the next free slot if free. */
+            uint32_t generation = 1;
+        };
+
+        std::vector<T> m_data;                /**< Dense element storage. */
+        std::vector<uint32_t> m_denseToSlot;  /**< Slot index of each element of m_data. */
+        std::vector<Slot> m_slots;
+        size_t m_nCapacity;
+        uint32_t m_iFreeHead = InvalidIndex;
+
+        static void bumpGeneration(Slot& slot)
+        {
+            slot.generation++;
+            if (slot.generation == 0)
+            {
+                // 0 is reserved for invalid handles
+                slot.generation = 1;
+            }
+        }
+
+        void releaseSlot(uint32_t iSlot)
+        {
+            Slot& slot = m_slots[iSlot];
+            bumpGeneration(slot);
+            slot.iDenseOrNextFree = m_iFreeHead;
+            m_iFreeHead = iSlot;
+        }
+
+        void linkFreeSlots()
+        {
+            for (size_t i = 0; i < m_nCapacity; i++)
+            {
+                m_slots[i].iDenseOrNextFree = (i + 1 < m_nCapacity) ? static_cast<uint32_t>(i + 1) : InvalidIndex;
+            }
+            m_iFreeHead = 0;
+        }
+
+    }; // class SlotMap
+
+} // namespace
@@ -0,0 +1,702 @@
+#pragma once
+
+/*
+    ###################################################################################
+    SmallVector.h
+    Vector container with inline capacity, storing the first N elements without heap allocation.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace pfl
+{
+    /**
+    * Drop-in replacement for std::vector for short lists, storing up to N elements inline, i.e. inside the object itself.
+    * The heap is used only when the size grows beyond N, after which the elements stay on the heap until destruction or shrink_to_fit().
+    *
+    * Differences from std::vector:
+    * - iterators are plain pointers;
+    * - moving a small_vector with inline storage moves the elements one by one, so it is O(n), and it invalidates iterators of the source;
+    * - growth always relocates elements with move construction, even if it might throw, so strong exception guarantee is not provided then;
+    * - no allocator support.
+    *
+    * Trivially copyable element types are copied and relocated with memcpy()/memmove().
+    */
+    template <typename T, size_t N>
+    class small_vector
+    {
+        static_assert(N > 0, "Inline capacity must be positive!");
+
+        typedef std::is_trivially_copyable<T> IsTrivial;  /**< Selects memcpy()/memmove() based element transfer. */
+
+    public:
+
+        typedef T value_type;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        small_vector() :
+            m_pData(inlineData())
+        {
+        }
+
+        explicit small_vector(size_t nCount) :
+            small_vector()
+        {
+            resize(nCount);
+        }
+
+        small_vector(size_t nCount, const T& value) :
+            small_vector()
+        {
+            assign(nCount, value);
+        }
+
+        template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        small_vector(InputIt first, InputIt last) :
+            small_vector()
+        {
+            assign(first, last);
+        }
+
+        small_vector(std::initializer_list<T> init) :
+            small_vector()
+        {
+            assign(init.begin(), init.end());
+        }
+
+        ~small_vector()
+        {
+            destroy(begin(), end());
+            freeHeap();
+        }
+
+        small_vector(const small_vector& other) :
+            small_vector()
+        {
+            reserve(other.m_nSize);
+            copyConstruct(m_pData, other.begin(), other.m_nSize);
+            m_nSize = other.m_nSize;
+        }
+
+        small_vector& operator=(const small_vector& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                reserve(other.m_nSize);
+                copyConstruct(m_pData, other.begin(), other.m_nSize);
+                m_nSize = other.m_nSize;
+            }
+            return *this;
+        }
+
+        small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) :
+            small_vector()
+        {
+            takeFrom(other);
+        }
+
+        small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            if (this != &other)
+            {
+                clear();
+                takeFrom(other);
+            }
+            return *this;
+        }
+
+        small_vector& operator=(std::initializer_list<T> init)
+        {
+            assign(init.begin(), init.end());
+            return *this;
+        }
+
+        void assign(size_t nCount, const T& value)
+        {
+            const T copy(value);  // value might be our own element
+            clear();
+            reserve(nCount);
+            std::uninitialized_fill_n(m_pData, nCount, copy);
+            m_nSize = nCount;
+        }
+
+        template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        void assign(InputIt first, InputIt last)
+        {
+            clear();
+            appendRange(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+        }
+
+        void assign(std::initializer_list<T> init)
+        {
+            assign(init.begin(), init.end());
+        }
+
+        // ---------------------------------------------------------------------------
+        // element access
+
+        T& operator[](size_t n)
+        {
+            assert(n < m_nSize);
+            return m_pData[n];
+        }
+
+        const T& operator[](size_t n) const
+        {
+            assert(n < m_nSize);
+            return m_pData[n];
+        }
+
+        /**
+        * Same as operator[] but checked.
+        * Exception is thrown if n is out of range.
+        */
+        T& at(size_t n)
+        {
+            if (n >= m_nSize)
+            {
+                throw std::out_of_range("Index is out of range!");
+            }
+            return m_pData[n];
+        }
+
+        const T& at(size_t n) const
+        {
+            if (n >= m_nSize)
+            {
+                throw std::out_of_range("Index is out of range!");
+            }
+            return m_pData[n];
+        }
+
+        T& front()
+        {
+            assert(m_nSize > 0);
+            return m_pData[0];
+        }
+
+        const T& front() const
+        {
+            assert(m_nSize > 0);
+            return m_pData[0];
+        }
+
+        T& back()
+        {
+            assert(m_nSize > 0);
+            return m_pData[m_nSize - 1];
+        }
+
+        const T& back() const
+        {
+            assert(m_nSize > 0);
+            return m_pData[m_nSize - 1];
+        }
+
+        T* data() noexcept
+        {
+            return m_pData;
+        }
+
+        const T* data() const noexcept
+        {
+            return m_pData;
+        }
+
+        // ---------------------------------------------------------------------------
+        // iterators
+
+        iterator begin() noexcept { return m_pData; }
+        const_iterator begin() const noexcept { return m_pData; }
+        const_iterator cbegin() const noexcept { return m_pData; }
+        iterator end() noexcept { return m_pData + m_nSize; }
+        const_iterator end() const noexcept { return m_pData + m_nSize; }
+        const_iterator cend() const noexcept { return m_pData + m_nSize; }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+        // ---------------------------------------------------------------------------
+        // capacity
+
+        bool empty() const noexcept
+        {
+            return m_nSize == 0;
+        }
+
+        size_t size() const noexcept
+        {
+            return m_nSize;
+        }
+
+        size_t max_size() const noexcept
+        {
+            return std::numeric_limits<size_t>::max() / sizeof(T);
+        }
+
+        size_t capacity() const noexcept
+        {
+            return m_nCapacity;
+        }
+
+        /**
+        * @return The inline capacity N.
+        */
+        static constexpr size_t inline_capacity() noexcept
+        {
+            return N;
+        }
+
+        /**
+        * @return True if the elements are stored inline, false if they are on the heap.
+        */
+        bool is_inline() const noexcept
+        {
+            return m_pData == inlineData();
+        }
+
+        void reserve(size_t nCapacity)
+        {
+            if (nCapacity > m_nCapacity)
+            {
+                reallocate(nCapacity);
+            }
+        }
+
+        /**
+        * Moves the elements back to inline storage if they fit, otherwise shrinks the heap block to size().
+        */
+        void shrink_to_fit()
+        {
+            if (is_inline() || (m_nSize == m_nCapacity))
+            {
+                return;
+            }
+
+            if (m_nSize <= N)
+            {
+                T* const pOld = m_pData;
+                relocate(inlineData(), pOld, m_nSize);
+                ::operator delete(pOld);
+                m_pData = inlineData();
+                m_nCapacity = N;
+            }
+            else
+            {
+                reallocate(m_nSize);
+            }
+        }
+
+        // ---------------------------------------------------------------------------
+        // modifiers
+
+        void clear() noexcept
+        {
+            destroy(begin(), end());
+            m_nSize = 0;
+        }
+
+        void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (m_nSize == m_nCapacity)
+            {
+                return growAndEmplaceBack(std::forward<Args>(args)...);
+            }
+            T* const p = new (m_pData + m_nSize) T(std::forward<Args>(args)...);
+            m_nSize++;
+            return *p;
+        }
+
+        void pop_back()
+        {
+            assert(m_nSize > 0);
+            m_nSize--;
+            m_pData[m_nSize].~T();
+        }
+
+        iterator insert(const_iterator pos, const T& value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        iterator insert(const_iterator pos, size_t nCount, const T& value)
+        {
+            const size_t iPos = indexOf(pos);
+            const T copy(value);  // value might be our own element
+            reserve(m_nSize + nCount);
+            std::uninitialized_fill_n(end(), nCount, copy);
+            m_nSize += nCount;
+            std::rotate(m_pData + iPos, end() - nCount, end());
+            return m_pData + iPos;
+        }
+
+        /**
+        * Inserts the elements of the given range before pos.
+        * The range must not refer to elements of this container.
+        */
+        template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        iterator insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            const size_t iPos = indexOf(pos);
+            const size_t nOldSize = m_nSize;
+            appendRange(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+            std::rotate(m_pData + iPos, m_pData + nOldSize, end());
+            return m_pData + iPos;
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<T> init)
+        {
+            return insert(pos, init.begin(), init.end());
+        }
+
+        template <typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
+        {
+            const size_t iPos = indexOf(pos);
+            if (iPos == m_nSize)
+            {
+                emplace_back(std::forward<Args>(args)...);
+                return m_pData + iPos;
+            }
+
+            T value(std::forward<Args>(args)...);  // args might refer to our own elements
+            reserve(m_nSize + 1);
+            T* const p = m_pData + iPos;
+            shiftInsert(p, value, IsTrivial());
+            m_nSize++;
+            return p;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            T* const pFirst = m_pData + indexOf(first);
+            T* const pLast = m_pData + indexOf(last);
+            if (pFirst == pLast)
+            {
+                return pFirst;
+            }
+
+            shiftErase(pFirst, pLast, IsTrivial());
+            m_nSize -= static_cast<size_t>(pLast - pFirst);
+            return pFirst;
+        }
+
+        void resize(size_t nCount)
+        {
+            if (nCount <= m_nSize)
+            {
+                destroy(m_pData + nCount, end());
+            }
+            else
+            {
+                reserve(nCount);
+                while (m_nSize < nCount)
+                {
+                    new (m_pData + m_nSize) T();
+                    m_nSize++;
+                }
+            }
+            m_nSize = nCount;
+        }
+
+        void resize(size_t nCount, const T& value)
+        {
+            if (nCount <= m_nSize)
+            {
+                destroy(m_pData + nCount, end());
+                m_nSize = nCount;
+            }
+            else
+            {
+                insert(end(), nCount - m_nSize, value);
+            }
+        }
+
+        void swap(small_vector& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            if (this == &other)
+            {
+                return;
+            }
+            small_vector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+    private:
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_inline[N];
+        T* m_pData;                    /**< Either m_inline or a heap block. */
+        size_t m_nSize = 0;
+        size_t m_nCapacity = N;
+
+        T* inlineData() noexcept
+        {
+            return reinterpret_cast<T*>(m_inline);
+        }
+
+        const T* inlineData() const noexcept
+        {
+            return reinterpret_cast<const T*>(m_inline);
+        }
+
+        size_t indexOf(const_iterator it) const
+        {
+            assert((it >= begin()) && (it <= end()));
+            return static_cast<size_t>(it - begin());
+        }
+
+        void freeHeap() noexcept
+        {
+            if (!is_inline())
+            {
+                ::operator delete(m_pData);
+            }
+        }
+
+        static void destroy(T* first, T* last) noexcept
+        {
+            for (; first != last; ++first)
+            {
+                first->~T();
+            }
+        }
+
+        static void copyConstruct(T* pDst, const T* pSrc, size_t n)
+        {
+            copyConstruct(pDst, pSrc, n, IsTrivial());
+        }
+
+        static void copyConstruct(T* pDst, const T* pSrc, size_t n, std::true_type)
+        {
+            if (n > 0)
+            {
+                memcpy(static_cast<void*>(pDst), static_cast<const void*>(pSrc), n * sizeof(T));
+            }
+        }
+
+        static void copyConstruct(T* pDst, const T* pSrc, size_t n, std::false_type)
+        {
+            std::uninitialized_copy(pSrc, pSrc + n, pDst);
+        }
+
+        /**
+        * Moves n elements from pSrc to uninitialized pDst and destroys the source elements.
+        */
+        static void relocate(T* pDst, T* pSrc, size_t n) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            relocate(pDst, pSrc, n, IsTrivial());
+        }
+
+        static void relocate(T* pDst, T* pSrc, size_t n, std::true_type) noexcept
+        {
+            if (n > 0)
+            {
+                memcpy(static_cast<void*>(pDst), static_cast<const void*>(pSrc), n * sizeof(T));
+            }
+        }
+
+        static void relocate(T* pDst, T* pSrc, size_t n, std::false_type) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                new (pDst + i) T(std::move(pSrc[i]));
+                pSrc[i].~T();
+            }
+        }
+
+        /**
+        * Shifts the elements from p to end() by one towards the end, then puts value to p. Capacity must be enough for one more element.
+        */
+        void shiftInsert(T* p, T& value, std::true_type)
+        {
+            memmove(static_cast<void*>(p + 1), static_cast<const void*>(p), static_cast<size_t>(end() - p) * sizeof(T));
+            memcpy(static_cast<void*>(p), static_cast<const void*>(&value), sizeof(T));
+        }
+
+        void shiftInsert(T* p, T& value, std::false_type)
+        {
+            new (end()) T(std::move(back()));
+            std::move_backward(p, end() - 1, end());
+            *p = std::move(value);
+        }
+
+        /**
+        * Shifts the elements from pLast to end() onto pFirst, then destroys the remaining tail. Size is not updated.
+        */
+        void shiftErase(T* pFirst, T* pLast, std::true_type)
+        {
+            memmove(static_cast<void*>(pFirst), static_cast<const void*>(pLast), static_cast<size_t>(end() - pLast) * sizeof(T));
+        }
+
+        void shiftErase(T* pFirst, T* pLast, std::false_type)
+        {
+            T* const pNewEnd = std::move(pLast, end(), pFirst);
+            destroy(pNewEnd, end());
+        }
+
+        static T* allocateHeap(size_t nCapacity)
+        {
+            if (nCapacity > std::numeric_limits<size_t>::max() / sizeof(T))
+            {
+                throw std::length_error("Capacity is too big!");
+            }
+            return static_cast<T*>(::operator new(nCapacity * sizeof(T)));
+        }
+
+        size_t grownCapacity(size_t nMinCapacity) const
+        {
+            return std::max(nMinCapacity, 2 * m_nCapacity);
+        }
+
+        void reallocate(size_t nCapacity)
+        {
+            T* const pNew = allocateHeap(nCapacity);
+            relocate(pNew, m_pData, m_nSize);
+            freeHeap();
+            m_pData = pNew;
+            m_nCapacity = nCapacity;
+        }
+
+        template <typename... Args>
+        T& growAndEmplaceBack(Args&&... args)
+        {
+            const size_t nNewCapacity = grownCapacity(m_nSize + 1);
+            T* const pNew = allocateHeap(nNewCapacity);
+            // construct the new element first, args might refer to our own elements
+            try
+            {
+                new (pNew + m_nSize) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                ::operator delete(pNew);
+                throw;
+            }
+            relocate(pNew, m_pData, m_nSize);
+            freeHeap();
+            m_pData = pNew;
+            m_nCapacity = nNewCapacity;
+            m_nSize++;
+            return m_pData[m_nSize - 1];
+        }
+
+        template <typename InputIt>
+        void appendRange(InputIt first, InputIt last, std::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+
+        template <typename ForwardIt>
+        void appendRange(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+        {
+            const size_t nCount = static_cast<size_t>(std::distance(first, last));
+            if (m_nSize + nCount > m_nCapacity)
+            {
+                reallocate(grownCapacity(m_nSize + nCount));
+            }
+            std::uninitialized_copy(first, last, end());
+            m_nSize += nCount;
+        }
+
+        /**
+        * Takes the elements of other, leaving it empty. This must be empty before.
+        */
+        void takeFrom(small_vector& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            if (other.is_inline())
+            {
+                // fits into our storage for sure
+                relocate(m_pData, other.m_pData, other.m_nSize);
+                m_nSize = other.m_nSize;
+            }
+            else
+            {
+                freeHeap();
+                m_pData = other.m_pData;
+                m_nSize = other.m_nSize;
+                m_nCapacity = other.m_nCapacity;
+                other.m_pData = other.inlineData();
+                other.m_nCapacity = N;
+            }
+            other.m_nSize = 0;
+        }
+
+    }; // class small_vector
+
+    template <typename T, size_t N>
+    bool operator==(const small_vector<T, N>& lhs, const small_vector<T, N>& rhs)
+    {
+        return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <typename T, size_t N>
+    bool operator!=(const small_vector<T, N>& lhs, const small_vector<T, N>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <typename T, size_t N>
+    bool operator<(const small_vector<T, N>& lhs, const small_vector<T, N>& rhs)
+    {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <typename T, size_t N>
+    void swap(small_vector<T, N>& lhs, small_vector<T, N>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+    {
+        lhs.swap(rhs);
+    }
+
+} // namespace
@@ -0,0 +1,268 @@
+#pragma once
+
+/*
+    ###################################################################################
+    SnapshotDelta.h
+    Field-wise delta encoding of fixed-layout snapshots against a baseline kept in a FixFIFO history.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "FixFIFO.h"
+
+/**
+    Creates a pfl::SnapshotField descriptor for the given member of the given snapshot type.
+
+    Example:
+      static const pfl::SnapshotDelta<PlayerState> codec({
+          PFL_SNAPSHOT_FIELD(PlayerState, pos),
+          PFL_SNAPSHOT_FIELD(PlayerState, health)
+      });
+*/
+#define PFL_SNAPSHOT_FIELD(Type, member) ( pfl::SnapshotField{ offsetof(Type, member), sizeof(static_cast<Type*>(nullptr)->member) } )
+
+namespace pfl
+{
+    /**
+    * Describes a single field of a snapshot: a contiguous byte range that is either sent completely or not at all.
+    * Use PFL_SNAPSHOT_FIELD() to fill it.
+    */
+    struct SnapshotField
+    {
+        size_t nOffset;  /**< Byte offset of the field inside the snapshot. */
+        size_t nSize;    /**< Size of the field in bytes. */
+    };
+
+    /**
+    * Element type to be stored in a FixFIFO history of snapshots, so the acknowledged baseline can be found by its sequence number.
+    */
+    template <typename TSnapshot>
+    struct SequencedSnapshot
+    {
+        uint32_t  nSequence;  /**< Sequence number of the snapshot, increasing with each push_back() into the history. */
+        TSnapshot snapshot;
+    };
+
+    /**
+    * Finds a snapshot with the given sequence number in the given history.
+    * Sequence numbers in the history are expected to be increasing in queue order, but not necessarily contiguous.
+    * Wraparound of the 32-bit sequence number is handled (serial number arithmetic).
+    * Complexity: O(log N) binary search.
+    *
+    * @param history   History of snapshots, oldest at front().
+    * @param nSequence Sequence number of the wanted snapshot, usually the last one acknowledged by the client.
+    *
+    * @return Pointer to the found snapshot, or nullptr if it is not (or no longer) in the history.
+    *         The pointer is valid until the next modification of the history.
+    */
+    template <typename TSnapshot>
+    const TSnapshot* findSnapshotBySequence(const FixFIFO<SequencedSnapshot<TSnapshot>>& history, const uint32_t& nSequence)
+    {
+        size_t iLow = 0;
+        size_t iHigh = history.size();
+        while (iLow < iHigh)
+        {
+            const size_t iMid = iLow + (iHigh - iLow) / 2;
+            const SequencedSnapshot<TSnapshot>& elem = history.at(iMid);
+            const int32_t nDiff = static_cast<int32_t>(elem.nSequence - nSequence);
+            if (nDiff == 0)
+            {
+                return &elem.snapshot;
+            }
+            else if (nDiff < 0)
+            {
+                iLow = iMid + 1;
+            }
+            else
+            {
+                iHigh = iMid;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+    * Delta encoder and decoder for snapshots of a trivially copyable type.
+    *
+    * The snapshot is split into fields given at construction time. Encoding compares each field of the current snapshot to the same field
+    * of the baseline snapshot, and emits a changed-field bitmask followed by the raw bytes of the changed fields only, in field order.
+    * Decoding copies the same baseline and overwrites the fields marked in the bitmask.
+    * Without a baseline, all fields are encoded, so the receiver can reconstruct the snapshot without having any earlier state.
+    *
+    * Wire format: ceil(numFields/8) bytes of bitmask (bit i of byte i/8 belongs to field i), then the changed fields' bytes.
+    * Sequence numbers are not part of the encoded data, those are expected in the enclosing message header.
+    * Fields are copied as raw bytes, so both sides must have the same endianness and type layout.
+    */
+    template <typename TSnapshot>
+    class SnapshotDelta
+    {
+        static_assert(std::is_trivially_copyable<TSnapshot>::value, "Snapshot type must be trivially copyable!");
+
+    public:
+
+        static constexpr size_t MaxFields = 64;  /**< Maximum number of fields, i.e. maximum number of bits in the changed-field bitmask. */
+
+        /**
+        * @param fields Fields of the snapshot type.
+        *               Must not be empty, must not have more than MaxFields elements, and every field must fit into the snapshot type.
+        *               Exception is thrown otherwise.
+        */
+        SnapshotDelta(std::initializer_list<SnapshotField> fields) :
+            m_fields(fields)
+        {
+            if (m_fields.empty() || (m_fields.size() > MaxFields))
+            {
+                throw std::runtime_error("Number of fields must be in range [1, MaxFields]!");
+            }
+
+            for (const auto& field : m_fields)
+            {
+                if ((field.nSize == 0) || (field.nOffset + field.nSize > sizeof(TSnapshot)))
+                {
+                    throw std::runtime_error("Field does not fit into the snapshot type!");
+                }
+            }
+        }
+
+        ~SnapshotDelta() = default;
+
+        SnapshotDelta(const SnapshotDelta&) = default;
+        SnapshotDelta& operator=(const SnapshotDelta&) = default;
+        SnapshotDelta(SnapshotDelta&&) = default;
+        SnapshotDelta& operator=(SnapshotDelta&&) = default;
+
+        /**
+        * @return Number of fields.
+        */
+        size_t numFields() const
+        {
+            return m_fields.size();
+        }
+
+        /**
+        * @return Size of the changed-field bitmask in bytes.
+        */
+        size_t maskSize() const
+        {
+            return (m_fields.size() + 7) / 8;
+        }
+
+        /**
+        * Appends the delta of current against baseline to the given buffer.
+        * Complexity: O(number of fields + size of changed fields).
+        *
+        * @param current   The snapshot to be encoded.
+        * @param pBaseline The snapshot already known by the receiver, e.g. as returned by findSnapshotBySequence().
+        *                  If nullptr, all fields are encoded.
+        * @param out       The encoded data is appended to this buffer.
+        *                  Previous content is kept, so reusing a cleared buffer across ticks avoids allocations.
+        *
+        * @return Number of bytes appended to out. Always at least maskSize().
+        */
+        size_t encode(const TSnapshot& current, const TSnapshot* pBaseline, std::vector<uint8_t>& out) const
+        {
+            const size_t iMask = out.size();
+            out.resize(iMask + maskSize(), 0u);
+
+            const uint8_t* const pCurrent = reinterpret_cast<const uint8_t*>(&current);
+            const uint8_t* const pBase = reinterpret_cast<const uint8_t*>(pBaseline);
+            for (size_t i = 0; i < m_fields.size(); i++)
+            {
+                const SnapshotField& field = m_fields[i];
+                if (pBase && (memcmp(pCurrent + field.nOffset, pBase + field.nOffset, field.nSize) == 0))
+                {
+                    continue;
+                }
+
+                out[iMask + i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+                out.insert(out.end(), pCurrent + field.nOffset, pCurrent + field.nOffset + field.nSize);
+            }
+
+            return out.size() - iMask;
+        }
+
+        /**
+        * Reconstructs a snapshot from data created by encode().
+        * Complexity: O(number of fields + size of changed fields).
+        *
+        * @param pData     The encoded data.
+        * @param nSize     Number of available bytes at pData. Extra bytes after the encoded snapshot are not touched.
+        * @param pBaseline The same baseline snapshot that was given to encode().
+        *                  Can be nullptr only if all fields are present in the encoded data.
+        * @param out       The reconstructed snapshot. Left untouched if decoding fails.
+        *
+        * @return Number of bytes consumed from pData, or 0 if the data is truncated, marks fields that do not exist,
+        *         or would need a missing baseline.
+        */
+        size_t decode(const uint8_t* pData, size_t nSize, const TSnapshot* pBaseline, TSnapshot& out) const
+        {
+            if (!pData || (nSize < maskSize()))
+            {
+                return 0;
+            }
+
+            // validate before touching out so a bad packet cannot leave a half-decoded snapshot behind
+            const size_t nLastByteBits = m_fields.size() % 8;
+            if ((nLastByteBits != 0) && ((pData[maskSize() - 1] & ~((1u << nLastByteBits) - 1)) != 0))
+            {
+                // bits after the last field are never set by encode(), so this is corrupt data or a different field layout
+                return 0;
+            }
+
+            size_t nTotal = maskSize();
+            for (size_t i = 0; i < m_fields.size(); i++)
+            {
+                if (isFieldInMask(pData, i))
+                {
+                    nTotal += m_fields[i].nSize;
+                }
+                else if (!pBaseline)
+                {
+                    return 0;
+                }
+            }
+            if (nTotal > nSize)
+            {
+                return 0;
+            }
+
+            if (pBaseline && (pBaseline != &out))
+            {
+                out = *pBaseline;
+            }
+
+            uint8_t* const pOut = reinterpret_cast<uint8_t*>(&out);
+            const uint8_t* pSrc = pData + maskSize();
+            for (size_t i = 0; i < m_fields.size(); i++)
+            {
+                if (isFieldInMask(pData, i))
+                {
+                    memcpy(pOut + m_fields[i].nOffset, pSrc, m_fields[i].nSize);
+                    pSrc += m_fields[i].nSize;
+                }
+            }
+
+            return nTotal;
+        }
+
+    private:
+        std::vector<SnapshotField> m_fields;  /**< Fields of the snapshot, in wire order. */
+
+        static bool isFieldInMask(const uint8_t* pMask, size_t iField)
+        {
+            return (pMask[iField / 8] & (1u << (iField % 8))) != 0;
+        }
+
+    }; // class SnapshotDelta
+
+} // namespace
@@ -0,0 +1,206 @@
+/*
+    ###################################################################################
+    TickScheduler.cpp
+    Fixed-timestep tick scheduling with hybrid sleep/spin frame pacing and jitter statistics.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include "TickScheduler.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+    /** Initial guess of how long a 1 ms sleep takes, before any measurement. Pessimistic, so early ticks are not late. */
+    constexpr double fInitialSleepEstimateUs = 2000.0;
+
+    /** Sample count is capped at this, so the estimate keeps adapting to changes of OS timer behavior. */
+    constexpr uint64_t nMaxSleepSamples = 1000;
+
+    /**
+        Hint to the CPU that we are busy-waiting.
+    */
+    void cpuRelax()
+    {
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    } // cpuRelax()
+
+    int64_t toUs(const pfl::TickScheduler::Clock::duration& duration)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    } // toUs()
+
+} // namespace
+
+
+// ############################### PUBLIC ################################
+
+
+/**
+    @param fTickRateHz       Number of ticks per second.
+                             Must be positive.
+                             Exception is thrown for non-positive value.
+    @param nMaxTicksPerFrame Max number of ticks returned by a single beginFrame(). If more ticks are due, e.g. after a hitch,
+                             the rest are dropped instead of making the next frame even longer.
+                             Must be positive.
+                             Exception is thrown for zero value.
+*/
+pfl::TickScheduler::TickScheduler(double fTickRateHz, unsigned int nMaxTicksPerFrame) :
+    m_nMaxTicksPerFrame(nMaxTicksPerFrame),
+    m_fSleepMeanUs(fInitialSleepEstimateUs),
+    m_fSpinThresholdUs(fInitialSleepEstimateUs)
+{
+    if (!(fTickRateHz > 0.0))
+    {
+        throw std::runtime_error("Tick rate must be positive!");
+    }
+    if (!nMaxTicksPerFrame)
+    {
+        throw std::runtime_error("Max ticks per frame must be positive!");
+    }
+
+    m_tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fTickRateHz));
+    reset();
+} // TickScheduler()
+
+
+/**
+    Restarts ticking from now: the first tick is due immediately.
+    Useful after loading, when the time spent should not be caught up.
+*/
+void pfl::TickScheduler::reset()
+{
+    m_nextTick = Clock::now();
+    m_fAlpha = 0.f;
+} // reset()
+
+
+/**
+    Gets the number of ticks due since the last call, to be simulated now, and updates alpha().
+    To be invoked once per frame.
+
+    @return Number of ticks to be simulated now, at most the max ticks per frame given in constructor. Might be 0.
+*/
+unsigned int pfl::TickScheduler::beginFrame()
+{
+    const Clock::time_point now = Clock::now();
+
+    unsigned int nTicks = 0;
+    while ((now >= m_nextTick) && (nTicks < m_nMaxTicksPerFrame))
+    {
+        nTicks++;
+        m_nextTick += m_tickDuration;
+    }
+
+    if (now >= m_nextTick)
+    {
+        // too much behind, skip the rest without simulating it
+        const Clock::duration::rep nDropped = (now - m_nextTick) / m_tickDuration + 1;
+        m_nextTick += nDropped * m_tickDuration;
+        m_stats.nDroppedTicks += static_cast<uint64_t>(nDropped);
+    }
+    m_stats.nTicks += nTicks;
+
+    // time until next tick is in (0, tickDuration] here
+    const double fRemaining = std::chrono::duration<double>(m_nextTick - now) / std::chrono::duration<double>(m_tickDuration);
+    m_fAlpha = static_cast<float>(1.0 - fRemaining);
+    if (m_fAlpha < 0.f)
+    {
+        m_fAlpha = 0.f;
+    }
+    return nTicks;
+} // beginFrame()
+
+
+/**
+    Blocks until the next tick is due, with hybrid sleep/spin, and records wake-up jitter.
+    Returns immediately if the next tick is already due, counting it as overrun.
+*/
+void pfl::TickScheduler::waitForNextTick()
+{
+    if (Clock::now() >= m_nextTick)
+    {
+        m_stats.nOverruns++;
+        return;
+    }
+
+    sleepUntil(m_nextTick);
+
+    const int64_t nLateUs = toUs(Clock::now() - m_nextTick);
+    m_stats.nWaits++;
+    m_stats.fJitterMeanUs += (static_cast<double>(nLateUs) - m_stats.fJitterMeanUs) / static_cast<double>(m_stats.nWaits);
+    if (nLateUs > m_stats.nJitterMaxUs)
+    {
+        m_stats.nJitterMaxUs = nLateUs;
+    }
+} // waitForNextTick()
+
+
+/**
+    Blocks until the given time.
+    Sleeps in 1 ms steps as long as the remaining time is more than a pessimistic estimate of a 1 ms sleep, then spins until the deadline.
+    Every sleep is measured to refine the estimate, so spinning is kept as short as the OS allows.
+*/
+void pfl::TickScheduler::sleepUntil(const Clock::time_point& deadline)
+{
+    for (;;)
+    {
+        const Clock::time_point before = Clock::now();
+        if (static_cast<double>(toUs(deadline - before)) <= m_fSpinThresholdUs)
+        {
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        addSleepSample(std::chrono::duration<double, std::micro>(Clock::now() - before).count());
+    }
+
+    while (Clock::now() < deadline)
+    {
+        cpuRelax();
+    }
+} // sleepUntil()
+
+
+// ############################## PROTECTED ##############################
+
+
+// ############################### PRIVATE ###############################
+
+
+/**
+    Updates the spin threshold with the given observed duration of a 1 ms sleep: mean plus one standard deviation.
+*/
+void pfl::TickScheduler::addSleepSample(double fObservedUs)
+{
+    if (m_nSleepSamples < nMaxSleepSamples)
+    {
+        m_nSleepSamples++;
+    }
+    else
+    {
+        // forget old samples gradually
+        m_fSleepM2 *= static_cast<double>(nMaxSleepSamples - 1) / static_cast<double>(nMaxSleepSamples);
+    }
+
+    const double fDelta = fObservedUs - m_fSleepMeanUs;
+    m_fSleepMeanUs += fDelta / static_cast<double>(m_nSleepSamples);
+    m_fSleepM2 += fDelta * (fObservedUs - m_fSleepMeanUs);
+
+    const double fStdDev = std::sqrt(m_fSleepM2 / static_cast<double>(m_nSleepSamples));
+    m_fSpinThresholdUs = m_fSleepMeanUs + fStdDev;
+} // addSleepSample()
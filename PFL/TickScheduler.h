@@ -0,0 +1,144 @@
+#pragma once
+
+/*
+    ###################################################################################
+    TickScheduler.h
+    Fixed-timestep tick scheduling with hybrid sleep/spin frame pacing and jitter statistics.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <chrono>
+#include <cstdint>
+
+namespace pfl
+{
+    /**
+    * Holds a fixed tick rate for simulation.
+    *
+    * Tick deadlines are placed exactly one tick duration apart on the steady clock, so lateness of a tick does not delay later
+    * ticks (no drift). Two ways of use:
+    *
+    * Dedicated server, ticking at exactly the tick rate:
+    * @code
+    * for (;;)
+    * {
+    *     scheduler.waitForNextTick();
+    *     for (unsigned i = scheduler.beginFrame(); i > 0; i--)
+    *     {
+    *         simulateTick();
+    *     }
+    * }
+    * @endcode
+    *
+    * Client, rendering as fast as possible (or vsync'd) with fixed-timestep simulation:
+    * @code
+    * for (;;)
+    * {
+    *     for (unsigned i = scheduler.beginFrame(); i > 0; i--)
+    *     {
+    *         simulateTick();
+    *     }
+    *     render(scheduler.alpha());
+    * }
+    * @endcode
+    *
+    * Waiting sleeps for the bulk of the time and spins for the last stretch. The spin length is calibrated continuously from the
+    * observed length of 1 ms sleeps, so it adapts to the OS timer resolution. On Windows, raising the timer resolution with
+    * timeBeginPeriod(1) greatly reduces the time spent spinning.
+    *
+    * Not thread-safe.
+    */
+    class TickScheduler
+    {
+
+    public:
+
+        typedef std::chrono::steady_clock Clock;
+
+        struct Statistics
+        {
+            uint64_t nTicks = 0;           /**< Number of ticks returned by beginFrame(). */
+            uint64_t nDroppedTicks = 0;    /**< Number of ticks skipped because more than the max ticks per frame were due. */
+            uint64_t nWaits = 0;           /**< Number of waitForNextTick() calls which actually waited. */
+            uint64_t nOverruns = 0;        /**< Number of waitForNextTick() calls when the next tick was already due, i.e. the previous tick took too long. */
+            double   fJitterMeanUs = 0.0;  /**< Mean lateness of waking up, relative to the tick deadline. */
+            int64_t  nJitterMaxUs = 0;     /**< Max lateness of waking up, relative to the tick deadline. */
+        };
+
+        TickScheduler(double fTickRateHz, unsigned int nMaxTicksPerFrame = 8);
+        ~TickScheduler() = default;
+
+        TickScheduler(const TickScheduler&) = default;
+        TickScheduler& operator=(const TickScheduler&) = default;
+        TickScheduler(TickScheduler&&) = default;
+        TickScheduler& operator=(TickScheduler&&) = default;
+
+        void reset();                                      /**< Restarts ticking from now. */
+        unsigned int beginFrame();                         /**< Gets the number of ticks to be simulated now. */
+        void waitForNextTick();                            /**< Blocks until the next tick is due. */
+        void sleepUntil(const Clock::time_point& deadline); /**< Blocks until the given time using hybrid sleep/spin. */
+
+        /**
+        * @return Fraction of the current tick elapsed at the last beginFrame(), in range [0, 1).
+        *         For rendering interpolated between the previous and the latest simulated state.
+        */
+        float alpha() const
+        {
+            return m_fAlpha;
+        }
+
+        /**
+        * @return Duration of a tick.
+        */
+        const Clock::duration& tickDuration() const
+        {
+            return m_tickDuration;
+        }
+
+        /**
+        * @return Deadline of the next tick.
+        */
+        const Clock::time_point& nextTickTime() const
+        {
+            return m_nextTick;
+        }
+
+        /**
+        * @return The current estimate of how long a 1 ms sleep can take, i.e. the remaining time below which waiting spins instead of sleeping.
+        */
+        int64_t getSpinThresholdUs() const
+        {
+            return static_cast<int64_t>(m_fSpinThresholdUs);
+        }
+
+        const Statistics& getStatistics() const
+        {
+            return m_stats;
+        }
+
+        void resetStatistics()
+        {
+            m_stats = Statistics();
+        }
+
+    private:
+        Clock::duration m_tickDuration;
+        unsigned int m_nMaxTicksPerFrame;
+        Clock::time_point m_nextTick;
+        float m_fAlpha = 0.f;
+        Statistics m_stats;
+
+        // running mean and variance (Welford) of observed 1 ms sleep durations
+        double m_fSleepMeanUs;
+        double m_fSleepM2 = 0.0;
+        uint64_t m_nSleepSamples = 1;
+        double m_fSpinThresholdUs;
+
+        void addSleepSample(double fObservedUs);
+
+    }; // class TickScheduler
+
+} // namespace
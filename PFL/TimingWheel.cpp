@@ -0,0 +1,462 @@
+/*
+    ###################################################################################
+    TimingWheel.cpp
+    Hierarchical timing wheel for large numbers of timers with O(1) schedule and cancel.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include "TimingWheel.h"
+
+#include <cassert>
+#include <stdexcept>
+
+
+constexpr unsigned int pfl::TimingWheel::SlotBits;
+constexpr unsigned int pfl::TimingWheel::NumSlots;
+constexpr unsigned int pfl::TimingWheel::NumLevels;
+constexpr uint32_t pfl::TimingWheel::InvalidIndex;
+constexpr uint32_t pfl::TimingWheel::ExpiringList;
+
+
+// ############################### PUBLIC ################################
+
+
+/**
+    @param capacity Max number of pending timers.
+                    Must be positive and less than 2^32-1.
+                    Exception is thrown for zero or too big value.
+    @param nTickUs  Length of a tick in microseconds, i.e. the resolution of timers.
+                    Must be positive.
+                    Exception is thrown for non-positive value.
+*/
+pfl::TimingWheel::TimingWheel(const size_t& capacity, int64_t nTickUs) :
+    m_nTickUs(nTickUs)
+{
+    if (!capacity)
+    {
+        throw std::runtime_error("Capacity must be positive!");
+    }
+    if (capacity >= InvalidIndex)
+    {
+        throw std::runtime_error("Capacity is too big!");
+    }
+    if (nTickUs <= 0)
+    {
+        throw std::runtime_error("Tick length must be positive!");
+    }
+
+    m_nodes.resize(capacity);
+    for (size_t i = 0; i < capacity; i++)
+    {
+        m_nodes[i].iNext = (i + 1 < capacity) ? static_cast<uint32_t>(i + 1) : InvalidIndex;
+    }
+    m_iFreeHead = 0;
+    m_lists.fill(InvalidIndex);
+    m_occupied.fill(0);
+
+    PFL::gettimeofday(&m_timeStart, nullptr);
+} // TimingWheel()
+
+
+/**
+    Schedules a timer relative to the time of the last advance().
+    Complexity: O(1) constant.
+
+    @param nDelayUs  Delay in microseconds.
+    @param nUserData Value passed to the expiry callback, e.g. an entity id.
+
+    @return Handle of the timer, or an invalid handle if capacity is reached.
+*/
+pfl::TimerHandle pfl::TimingWheel::schedule(int64_t nDelayUs, uint64_t nUserData)
+{
+    return scheduleAt(m_nNowUs + nDelayUs, nUserData);
+} // schedule()
+
+
+/**
+    Schedules a timer at the given time.
+    A time not later than now() makes the timer expire in the next tick.
+    Complexity: O(1) constant.
+
+    @param nExpireUs Expiry time in microseconds, on the same scale as advance().
+    @param nUserData Value passed to the expiry callback, e.g. an entity id.
+
+    @return Handle of the timer, or an invalid handle if capacity is reached.
+*/
+pfl::TimerHandle pfl::TimingWheel::scheduleAt(int64_t nExpireUs, uint64_t nUserData)
+{
+    if (m_iFreeHead == InvalidIndex)
+    {
+        return TimerHandle();
+    }
+
+    const uint32_t iNode = m_iFreeHead;
+    Node& node = m_nodes[iNode];
+    m_iFreeHead = node.iNext;
+
+    // rounded up, so the timer never expires early
+    node.nExpireTick = (nExpireUs <= 0) ? 0 : static_cast<uint64_t>((nExpireUs + m_nTickUs - 1) / m_nTickUs);
+    node.nUserData = nUserData;
+    place(iNode);
+    m_nSize++;
+
+    TimerHandle handle;
+    handle.index = iNode;
+    handle.generation = node.generation;
+    return handle;
+} // scheduleAt()
+
+
+/**
+    Changes the expiry of a pending timer, keeping its handle.
+    Complexity: O(1) constant.
+
+    @param handle   The timer.
+    @param nDelayUs New delay relative to now(), in microseconds.
+
+    @return True if the timer has been rescheduled, false if the handle is invalid or stale.
+*/
+bool pfl::TimingWheel::reschedule(const TimerHandle& handle, int64_t nDelayUs)
+{
+    if (!isPending(handle))
+    {
+        return false;
+    }
+
+    const int64_t nExpireUs = m_nNowUs + nDelayUs;
+    Node& node = m_nodes[handle.index];
+    unlink(handle.index);
+    node.nExpireTick = (nExpireUs <= 0) ? 0 : static_cast<uint64_t>((nExpireUs + m_nTickUs - 1) / m_nTickUs);
+    place(handle.index);
+    return true;
+} // reschedule()
+
+
+/**
+    Cancels a pending timer. Can be invoked from the expiry callback too, even for timers expiring in the same advance().
+    Complexity: O(1) constant.
+
+    @return True if the timer has been cancelled, false if the handle is invalid or stale.
+*/
+bool pfl::TimingWheel::cancel(const TimerHandle& handle)
+{
+    if (!isPending(handle))
+    {
+        return false;
+    }
+
+    unlink(handle.index);
+    freeNode(handle.index);
+    return true;
+} // cancel()
+
+
+bool pfl::TimingWheel::isPending(const TimerHandle& handle) const
+{
+    return (handle.index < m_nodes.size()) &&
+        handle.isValid() &&
+        (m_nodes[handle.index].generation == handle.generation) &&
+        (m_nodes[handle.index].iList != InvalidIndex);
+} // isPending()
+
+
+/**
+    Advances time to the given time, and invokes the callback for each expired timer.
+    The callback may schedule, reschedule and cancel timers. Timers scheduled from the callback to a time not later than
+    the current tick expire in the next tick at the earliest, so a timer rescheduling itself cannot loop forever.
+
+    @param nNowUs    Current time in microseconds. Earlier time than in a previous call is ignored.
+    @param onExpired Invoked for each expired timer, in order of expiry tick. Its handle is already stale when invoked.
+
+    @return Number of expired timers.
+*/
+size_t pfl::TimingWheel::advance(int64_t nNowUs, const ExpiryCallback& onExpired)
+{
+    if (nNowUs <= m_nNowUs)
+    {
+        return 0;
+    }
+    m_nNowUs = nNowUs;
+
+    const uint64_t nTargetTick = static_cast<uint64_t>(nNowUs / m_nTickUs);
+    size_t nExpired = 0;
+    while (m_nCurrentTick <= nTargetTick)
+    {
+        if (m_nSize == 0)
+        {
+            // nothing to process, jump
+            m_nCurrentTick = nTargetTick + 1;
+            break;
+        }
+        skipEmptyTicks(nTargetTick);
+        if (m_nCurrentTick > nTargetTick)
+        {
+            break;
+        }
+        nExpired += processTick(onExpired);
+    }
+    return nExpired;
+} // advance()
+
+
+/**
+    Same as advance(nNowUs, onExpired), with the time elapsed since construction, measured with PFL::gettimeofday().
+*/
+size_t pfl::TimingWheel::advance(const ExpiryCallback& onExpired)
+{
+    return advance(elapsedUs(), onExpired);
+} // advance()
+
+
+/**
+    @return Microseconds elapsed since construction, measured with PFL::gettimeofday().
+*/
+int64_t pfl::TimingWheel::elapsedUs() const
+{
+    PFL::timeval timeNow;
+    PFL::gettimeofday(&timeNow, nullptr);
+    // PFL::getTimeDiffInUs() is not used as its long result overflows after 35 minutes where long is 32-bit
+    return static_cast<int64_t>(timeNow.tv_sec - m_timeStart.tv_sec) * 1000000 + (timeNow.tv_usec - m_timeStart.tv_usec);
+} // elapsedUs()
+
+
+// ############################## PROTECTED ##############################
+
+
+// ############################### PRIVATE ###############################
+
+
+/**
+    Inserts the given node at the head of the given list.
+*/
+void pfl::TimingWheel::link(uint32_t iNode, uint32_t iList)
+{
+    Node& node = m_nodes[iNode];
+    node.iList = iList;
+    node.iPrev = InvalidIndex;
+    node.iNext = m_lists[iList];
+    if (node.iNext != InvalidIndex)
+    {
+        m_nodes[node.iNext].iPrev = iNode;
+    }
+    m_lists[iList] = iNode;
+    if (iList != ExpiringList)
+    {
+        m_occupied[iList / 64] |= uint64_t(1) << (iList % 64);
+    }
+} // link()
+
+
+/**
+    Removes the given node from its list.
+*/
+void pfl::TimingWheel::unlink(uint32_t iNode)
+{
+    Node& node = m_nodes[iNode];
+    assert(node.iList != InvalidIndex);
+    if (node.iPrev != InvalidIndex)
+    {
+        m_nodes[node.iPrev].iNext = node.iNext;
+    }
+    else
+    {
+        m_lists[node.iList] = node.iNext;
+        if ((node.iNext == InvalidIndex) && (node.iList != ExpiringList))
+        {
+            m_occupied[node.iList / 64] &= ~(uint64_t(1) << (node.iList % 64));
+        }
+    }
+    if (node.iNext != InvalidIndex)
+    {
+        m_nodes[node.iNext].iPrev = node.iPrev;
+    }
+    node.iPrev = InvalidIndex;
+    node.iNext = InvalidIndex;
+    node.iList = InvalidIndex;
+} // unlink()
+
+
+/**
+    Links the given node into the slot matching its expiry relative to the current tick.
+*/
+void pfl::TimingWheel::place(uint32_t iNode)
+{
+    const uint64_t nExpireTick = m_nodes[iNode].nExpireTick;
+    if (nExpireTick <= m_nCurrentTick)
+    {
+        // due: the slot of the next tick to be processed
+        link(iNode, static_cast<uint32_t>(m_nCurrentTick & (NumSlots - 1)));
+        return;
+    }
+
+    const uint64_t nDelta = nExpireTick - m_nCurrentTick;
+    for (unsigned int nLevel = 0; nLevel < NumLevels; nLevel++)
+    {
+        const unsigned int nShift = nLevel * SlotBits;
+        if ((nLevel == NumLevels - 1) || (nDelta < (uint64_t(1) << (nShift + SlotBits))))
+        {
+            // beyond the range of the top level, park in the farthest slot and cascade again from there
+            const uint64_t nMaxDelta = (uint64_t(1) << (NumLevels * SlotBits)) - 1;
+            const uint64_t nPlaceTick = (nDelta > nMaxDelta) ? (m_nCurrentTick + nMaxDelta) : nExpireTick;
+            const uint32_t iSlot = static_cast<uint32_t>((nPlaceTick >> nShift) & (NumSlots - 1));
+            link(iNode, nLevel * NumSlots + iSlot);
+            return;
+        }
+    }
+} // place()
+
+
+/**
+    Re-places all timers of the given slot of the given level, moving them to lower levels.
+*/
+void pfl::TimingWheel::cascade(unsigned int nLevel, uint32_t iSlot)
+{
+    const uint32_t iList = nLevel * NumSlots + iSlot;
+    uint32_t iNode = m_lists[iList];
+    m_lists[iList] = InvalidIndex;
+    m_occupied[iList / 64] &= ~(uint64_t(1) << (iList % 64));
+    while (iNode != InvalidIndex)
+    {
+        const uint32_t iNext = m_nodes[iNode].iNext;
+        m_nodes[iNode].iList = InvalidIndex;
+        place(iNode);
+        iNode = iNext;
+    }
+} // cascade()
+
+
+void pfl::TimingWheel::freeNode(uint32_t iNode)
+{
+    Node& node = m_nodes[iNode];
+    node.generation++;
+    if (node.generation == 0)
+    {
+        // 0 is reserved for invalid handles
+        node.generation = 1;
+    }
+    node.iNext = m_iFreeHead;
+    m_iFreeHead = iNode;
+    m_nSize--;
+} // freeNode()
+
+
+bool pfl::TimingWheel::isOccupied(uint32_t iList) const
+{
+    return (m_occupied[iList / 64] & (uint64_t(1) << (iList % 64))) != 0;
+} // isOccupied()
+
+
+bool pfl::TimingWheel::isLevelEmpty(unsigned int nLevel) const
+{
+    for (unsigned int i = nLevel * NumSlots / 64; i < (nLevel + 1) * NumSlots / 64; i++)
+    {
+        if (m_occupied[i] != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+} // isLevelEmpty()
+
+
+/**
+    Tells if processing the given tick would expire or cascade any timer.
+*/
+bool pfl::TimingWheel::hasWork(uint64_t nTick) const
+{
+    if (isOccupied(static_cast<uint32_t>(nTick & (NumSlots - 1))))
+    {
+        return true;
+    }
+    for (unsigned int nLevel = 1; nLevel < NumLevels; nLevel++)
+    {
+        if ((nTick & ((uint64_t(1) << (nLevel * SlotBits)) - 1)) != 0)
+        {
+            break;
+        }
+        if (isOccupied(nLevel * NumSlots + static_cast<uint32_t>((nTick >> (nLevel * SlotBits)) & (NumSlots - 1))))
+        {
+            return true;
+        }
+    }
+    return false;
+} // hasWork()
+
+
+/**
+    Moves m_nCurrentTick forward, up to nLastTick+1, over ticks having nothing to do.
+    If the lowest levels are all empty, nothing can happen before the next tick cascading the lowest non-empty level, so we jump there.
+*/
+void pfl::TimingWheel::skipEmptyTicks(uint64_t nLastTick)
+{
+    while ((m_nCurrentTick <= nLastTick) && !hasWork(m_nCurrentTick))
+    {
+        unsigned int nLevel = 0;
+        while ((nLevel < NumLevels - 1) && isLevelEmpty(nLevel))
+        {
+            nLevel++;
+        }
+
+        uint64_t nNextTick;
+        if (nLevel == 0)
+        {
+            // skip the rest of the current 64 slots if they are empty
+            const uint32_t iSlot = static_cast<uint32_t>(m_nCurrentTick & (NumSlots - 1));
+            nNextTick = (m_occupied[iSlot / 64] == 0) ? (m_nCurrentTick + (64 - (iSlot % 64))) : (m_nCurrentTick + 1);
+        }
+        else
+        {
+            const uint64_t nMask = (uint64_t(1) << (nLevel * SlotBits)) - 1;
+            nNextTick = (m_nCurrentTick | nMask) + 1;
+        }
+        m_nCurrentTick = (nNextTick <= nLastTick) ? nNextTick : (nLastTick + 1);
+    }
+} // skipEmptyTicks()
+
+
+/**
+    Processes m_nCurrentTick: cascades higher levels if level 0 wraps around, then expires the timers of the current level 0 slot.
+    @return Number of expired timers.
+*/
+size_t pfl::TimingWheel::processTick(const ExpiryCallback& onExpired)
+{
+    const uint64_t nTick = m_nCurrentTick;
+    for (unsigned int nLevel = 1; nLevel < NumLevels; nLevel++)
+    {
+        if ((nTick & ((uint64_t(1) << (nLevel * SlotBits)) - 1)) != 0)
+        {
+            break;
+        }
+        cascade(nLevel, static_cast<uint32_t>((nTick >> (nLevel * SlotBits)) & (NumSlots - 1)));
+    }
+
+    // move the slot to the expiring list, so the callback can cancel any of them, and timers it schedules go to later ticks
+    const uint32_t iSlot = static_cast<uint32_t>(nTick & (NumSlots - 1));
+    m_lists[ExpiringList] = m_lists[iSlot];
+    m_lists[iSlot] = InvalidIndex;
+    m_occupied[iSlot / 64] &= ~(uint64_t(1) << (iSlot % 64));
+    for (uint32_t iNode = m_lists[ExpiringList]; iNode != InvalidIndex; iNode = m_nodes[iNode].iNext)
+    {
+        m_nodes[iNode].iList = ExpiringList;
+    }
+    m_nCurrentTick = nTick + 1;
+
+    size_t nExpired = 0;
+    while (m_lists[ExpiringList] != InvalidIndex)
+    {
+        const uint32_t iNode = m_lists[ExpiringList];
+        TimerHandle handle;
+        handle.index = iNode;
+        handle.generation = m_nodes[iNode].generation;
+        const uint64_t nUserData = m_nodes[iNode].nUserData;
+
+        unlink(iNode);
+        freeNode(iNode);
+        nExpired++;
+        onExpired(handle, nUserData);
+    }
+    return nExpired;
+} // processTick()
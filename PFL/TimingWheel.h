@@ -0,0 +1,154 @@
+#pragma once
+
+/*
+    ###################################################################################
+    TimingWheel.h
+    Hierarchical timing wheel for large numbers of timers with O(1) schedule and cancel.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "PFL.h"
+
+namespace pfl
+{
+    /**
+    * Handle of a timer scheduled in a TimingWheel.
+    * Becomes stale when the timer expires or is cancelled, even if its slot has been reused since then.
+    * Default-constructed handle is invalid.
+    */
+    struct TimerHandle
+    {
+        uint32_t index = 0;       /**< Index of the timer node. */
+        uint32_t generation = 0;  /**< Generation of the node when the timer was scheduled. Never 0 for handles returned by TimingWheel. */
+
+        bool isValid() const
+        {
+            return generation != 0;
+        }
+
+        bool operator==(const TimerHandle& other) const
+        {
+            return (index == other.index) && (generation == other.generation);
+        }
+
+        bool operator!=(const TimerHandle& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    /**
+    * Hierarchical timing wheel: 4 levels of 256 slots, each slot being an intrusive list of timers.
+    *
+    * Time advances in ticks of fixed length given in constructor. Level 0 holds timers expiring within 256 ticks, one slot per tick;
+    * each further level covers 256 times longer range with 256 times coarser slots. When level 0 wraps around, the next slot of
+    * level 1 is cascaded down into level 0, and so on, like in the classic Linux kernel timer wheel.
+    * Scheduling and cancelling are O(1). Advancing costs the work for expiring and cascaded timers plus a small constant per elapsed
+    * tick, independently of the number of pending timers. Ticks with nothing to do are skipped in bulk using occupancy bitmaps of the slots,
+    * so advancing over a long idle period is cheap too.
+    *
+    * Timers never expire early: a timer expires in the first advance() whose time is at or after its expiry time, rounded up to tick.
+    * Timers further than 2^32 ticks are kept in the last slot range and cascaded again until they are due.
+    *
+    * Not thread-safe.
+    */
+    class TimingWheel
+    {
+
+    public:
+
+        typedef std::function<void(const TimerHandle& handle, uint64_t nUserData)> ExpiryCallback;
+
+        static constexpr unsigned int SlotBits = 8;
+        static constexpr unsigned int NumSlots = 1u << SlotBits;
+        static constexpr unsigned int NumLevels = 4;
+
+        TimingWheel(const size_t& capacity, int64_t nTickUs = 1000);
+        ~TimingWheel() = default;
+
+        TimingWheel(const TimingWheel&) = default;
+        TimingWheel& operator=(const TimingWheel&) = default;
+        TimingWheel(TimingWheel&&) = default;
+        TimingWheel& operator=(TimingWheel&&) = default;
+
+        TimerHandle schedule(int64_t nDelayUs, uint64_t nUserData);      /**< Schedules a timer relative to now(). */
+        TimerHandle scheduleAt(int64_t nExpireUs, uint64_t nUserData);   /**< Schedules a timer at the given time. */
+        bool reschedule(const TimerHandle& handle, int64_t nDelayUs);    /**< Changes expiry of a pending timer, relative to now(). */
+        bool cancel(const TimerHandle& handle);                          /**< Cancels a pending timer. */
+        bool isPending(const TimerHandle& handle) const;                 /**< Tells if the given timer is still pending. */
+
+        size_t advance(int64_t nNowUs, const ExpiryCallback& onExpired); /**< Advances time to the given time and expires due timers. */
+        size_t advance(const ExpiryCallback& onExpired);                 /**< Advances time to elapsedUs() and expires due timers. */
+        int64_t elapsedUs() const;                                       /**< Gets time elapsed since construction using PFL::gettimeofday(). */
+
+        /**
+        * @return Time of the last advance() in microseconds, 0 before the first advance().
+        */
+        int64_t now() const
+        {
+            return m_nNowUs;
+        }
+
+        /**
+        * @return Number of pending timers.
+        */
+        size_t size() const
+        {
+            return m_nSize;
+        }
+
+        /**
+        * @return Max number of pending timers.
+        */
+        size_t capacity() const
+        {
+            return m_nodes.size();
+        }
+
+    private:
+        static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+        static constexpr uint32_t ExpiringList = NumLevels * NumSlots;  /**< Index of the list of timers being expired in m_lists. */
+
+        struct Node
+        {
+            uint64_t nExpireTick = 0;
+            uint64_t nUserData = 0;
+            uint32_t iPrev = InvalidIndex;
+            uint32_t iNext = InvalidIndex;  /**< Next node in the same list, or in the free list if free. */
+            uint32_t iList = InvalidIndex;  /**< Index of the list in m_lists containing this node, InvalidIndex if free. */
+            uint32_t generation = 1;
+        };
+
+        std::vector<Node> m_nodes;
+        std::array<uint32_t, NumLevels * NumSlots + 1> m_lists;  /**< Head node of each slot, plus the expiring list. */
+        std::array<uint64_t, NumLevels * NumSlots / 64> m_occupied;  /**< Bit i is set if slot list i in m_lists is not empty. */
+        uint32_t m_iFreeHead = InvalidIndex;
+        size_t m_nSize = 0;
+        int64_t m_nTickUs;
+        uint64_t m_nCurrentTick = 0;  /**< The next tick to be processed. */
+        int64_t m_nNowUs = 0;
+        PFL::timeval m_timeStart;
+
+        void link(uint32_t iNode, uint32_t iList);
+        void unlink(uint32_t iNode);
+        void place(uint32_t iNode);
+        void cascade(unsigned int nLevel, uint32_t iSlot);
+        void freeNode(uint32_t iNode);
+        bool isOccupied(uint32_t iList) const;
+        bool isLevelEmpty(unsigned int nLevel) const;
+        bool hasWork(uint64_t nTick) const;
+        void skipEmptyTicks(uint64_t nLastTick);
+        size_t processTick(const ExpiryCallback& onExpired);
+
+    }; // class TimingWheel
+
+} // namespace
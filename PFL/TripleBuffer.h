@@ -0,0 +1,160 @@
+#pragma once
+
+/*
+    ###################################################################################
+    TripleBuffer.h
+    Lock-free triple buffer for passing the newest complete frame of a big object from a producer to a consumer thread.
+    This file is part of PFL (PR00F Foundation Library).
+    Made by PR00F88
+    2026
+    ###################################################################################
+*/
+
+#include <atomic>
+#include <cstdint>
+
+namespace pfl
+{
+    /**
+    * Triple buffer: passes the newest complete value of an object from a single producer thread to a single consumer thread,
+    * e.g. the simulation state from the game thread to the render thread.
+    *
+    * Holds 3 instances: the back buffer written by the producer, the front buffer read by the consumer, and a middle one holding
+    * the latest published value. Publishing swaps the back and middle buffers, updating swaps the front and middle buffers, both by
+    * a single atomic exchange. So neither side ever waits or copies, the producer can publish at any rate, and the consumer always
+    * gets the newest published value, skipping older ones it did not get to.
+    *
+    * The back and front buffers are not reset by swapping: after publish(), back() holds an older value, which might be useful for
+    * incremental updates, or should be fully overwritten.
+    */
+    template <typename T>
+    class TripleBuffer
+    {
+
+    public:
+
+        TripleBuffer() = default;
+
+        /**
+        * @param value Initial value of all 3 buffers.
+        */
+        explicit TripleBuffer(const T& value)
+        {
+            for (auto& buffer : m_buffers)
+            {
+                buffer.value = value;
+            }
+        }
+
+        ~TripleBuffer() = default;
+
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+        TripleBuffer(TripleBuffer&&) = delete;
+        TripleBuffer& operator=(TripleBuffer&&) = delete;
+
+        /**
+        * @return The buffer to be written by the producer.
+        */
+        T& back()
+        {
+            return m_buffers[m_iBack].value;
+        }
+
+        /**
+        * Publishes the back buffer as the newest value, and gets another back buffer. Wait-free.
+        * To be invoked by the producer only.
+        */
+        void publish()
+        {
+            const uint8_t nOld = m_nMiddle.exchange(static_cast<uint8_t>(m_iBack | NewBit), std::memory_order_acq_rel);
+            m_iBack = nOld & IndexMask;
+        }
+
+        /**
+        * Copies the given value into the back buffer and publishes it.
+        * To be invoked by the producer only.
+        */
+        void write(const T& value)
+        {
+            back() = value;
+            publish();
+        }
+
+        /**
+        * Makes the newest published value the front buffer, if there is any newer than the current front buffer. Wait-free.
+        * To be invoked by the consumer only.
+        *
+        * @return True if front() has changed, false if nothing has been published since the last update.
+        */
+        bool update()
+        {
+            if ((m_nMiddle.load(std::memory_order_relaxed) & NewBit) == 0)
+            {
+                return false;
+            }
+            const uint8_t nOld = m_nMiddle.exchange(m_iFront, std::memory_order_acq_rel);
+            m_iFront = nOld & IndexMask;
+            return true;
+        }
+
+        /**
+        * @return The buffer to be read by the consumer, the newest published value as of the last update().
+        */
+        const T& front() const
+        {
+            return m_buffers[m_iFront].value;
+        }
+
+        /**
+        * Non-const version, so the consumer can move from the buffer or use it as scratch space.
+        */
+        T& front()
+        {
+            return m_buffers[m_iFront].value;
+        }
+
+        /**
+        * Same as update() followed by front().
+        */
+        const T& read()
+        {
+            update();
+            return front();
+        }
+
+        /**
+        * @return True if a value has been published since the last update(). Thread-safe.
+        */
+        bool hasNew() const
+        {
+            return (m_nMiddle.load(std::memory_order_relaxed) & NewBit) != 0;
+        }
+
+    private:
+        static constexpr uint8_t IndexMask = 3;
+        static constexpr uint8_t NewBit = 4;  /**< Set in m_nMiddle if published since the last update(). */
+
+        /** Buffers are padded so that the producer and consumer writing neighbour buffers do not share a cache line. */
+        struct PaddedBuffer
+        {
+            T value{};
+            char padding[64];
+        };
+
+        PaddedBuffer m_buffers[3];
+        uint8_t m_iBack = 0;                     /**< Accessed only by the producer. */
+        char m_padding0[64];
+        std::atomic<uint8_t> m_nMiddle{ 1 };     /**< Index of the middle buffer, and NewBit. */
+        char m_padding1[64];
+        uint8_t m_iFront = 2;                    /**< Accessed only by the consumer. */
+
+    }; // class TripleBuffer
+
+    template <typename T>
+    constexpr uint8_t TripleBuffer<T>::IndexMask;
+
+    template <typename T>
+    constexpr uint8_t TripleBuffer<T>::NewBit;
+
+} // namespace